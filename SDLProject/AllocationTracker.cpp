@@ -0,0 +1,239 @@
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#ifdef DEBUG
+#include <dlfcn.h>
+#endif
+
+namespace
+{
+    struct PhaseCounters
+    {
+        std::atomic<unsigned long> allocations;
+        std::atomic<unsigned long> bytes;
+        std::atomic<unsigned long> frees;
+    };
+
+    // Zero-initialised statics, so they're usable by allocations made before main()
+    PhaseCounters g_counters[AllocationTracker::PHASE_COUNT];
+    AllocationTracker::FrameStats g_last_frame;
+
+    std::atomic<bool> g_zero_alloc(false);
+
+    thread_local AllocationTracker::Phase t_phase = AllocationTracker::PHASE_OTHER;
+
+#ifdef DEBUG
+    // Open-addressed table of (call site, caller) pairs. Slots are claimed with
+    // a CAS on the key and never move, so recording never locks or allocates;
+    // when the table is full further sites only show up in the totals.
+    struct CallSite
+    {
+        std::atomic<uintptr_t>     key;
+        std::atomic<uintptr_t>     site, parent;
+        std::atomic<unsigned long> allocations, bytes;
+    };
+
+    CallSite g_call_sites[AllocationTracker::MAX_CALL_SITES];
+
+    void record_call_site(size_t bytes, void *site, void *parent)
+    {
+        uintptr_t key = (uintptr_t) site ^ ((uintptr_t) parent * 31);
+        if (key == 0) key = 1;
+
+        size_t start = (key >> 4) % AllocationTracker::MAX_CALL_SITES;
+        for (int probe = 0; probe < AllocationTracker::MAX_CALL_SITES; probe++)
+        {
+            CallSite &slot = g_call_sites[(start + probe) % AllocationTracker::MAX_CALL_SITES];
+
+            uintptr_t expected = 0;
+            if (slot.key.compare_exchange_strong(expected, key, std::memory_order_relaxed))
+            {
+                slot.site.store((uintptr_t) site, std::memory_order_relaxed);
+                slot.parent.store((uintptr_t) parent, std::memory_order_relaxed);
+            }
+            else if (expected != key) continue;
+
+            slot.allocations.fetch_add(1, std::memory_order_relaxed);
+            slot.bytes.fetch_add(bytes, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    void print_address(const char *label, uintptr_t address)
+    {
+        Dl_info info;
+        if (address != 0 && dladdr((void*) address, &info) && info.dli_sname != nullptr)
+        {
+            fprintf(stderr, "      %s %s+0x%lx\n", label, info.dli_sname,
+                    (unsigned long) (address - (uintptr_t) info.dli_saddr));
+        }
+        else
+        {
+            fprintf(stderr, "      %s 0x%lx\n", label, (unsigned long) address);
+        }
+    }
+#endif
+}
+
+// ————— FRAME BOOKKEEPING ————— //
+void AllocationTracker::set_phase(Phase phase) { t_phase = phase; }
+AllocationTracker::Phase AllocationTracker::get_phase() { return t_phase; }
+
+const char* AllocationTracker::phase_name(Phase phase)
+{
+    switch (phase)
+    {
+        case PHASE_INPUT:      return "input";
+        case PHASE_SIMULATION: return "simulation";
+        case PHASE_RENDER:     return "render";
+        case PHASE_DRIVER:     return "driver";
+        default:               return "other";
+    }
+}
+
+void AllocationTracker::end_frame()
+{
+    FrameStats stats;
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        PhaseStats &phase_stats = stats.phases[phase];
+        phase_stats.allocations = g_counters[phase].allocations.exchange(0, std::memory_order_relaxed);
+        phase_stats.bytes       = g_counters[phase].bytes.exchange(0, std::memory_order_relaxed);
+        phase_stats.frees       = g_counters[phase].frees.exchange(0, std::memory_order_relaxed);
+
+        stats.total.allocations += phase_stats.allocations;
+        stats.total.bytes       += phase_stats.bytes;
+        stats.total.frees       += phase_stats.frees;
+    }
+    g_last_frame = stats;
+
+    unsigned long own_allocations = stats.total.allocations - stats.phases[PHASE_DRIVER].allocations;
+    if (g_zero_alloc.load(std::memory_order_relaxed) && own_allocations > 0)
+    {
+        fprintf(stderr, "zero-alloc: a steady-state frame allocated\n");
+        print_report(stats);
+        abort();
+    }
+
+#ifdef DEBUG
+    // Call sites are per frame too
+    for (CallSite &slot : g_call_sites)
+    {
+        if (slot.key.load(std::memory_order_relaxed) == 0) continue;
+        slot.allocations.store(0, std::memory_order_relaxed);
+        slot.bytes.store(0, std::memory_order_relaxed);
+        slot.key.store(0, std::memory_order_relaxed);
+    }
+#endif
+}
+
+const AllocationTracker::FrameStats& AllocationTracker::get_frame_stats() { return g_last_frame; }
+
+void AllocationTracker::set_zero_alloc(bool enabled) { g_zero_alloc.store(enabled); }
+bool AllocationTracker::get_zero_alloc() { return g_zero_alloc.load(); }
+
+void AllocationTracker::print_report(const FrameStats &stats)
+{
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        const PhaseStats &phase_stats = stats.phases[phase];
+        fprintf(stderr, "  %-10s %6lu allocations %9lu bytes %6lu frees\n", phase_name((Phase) phase),
+                phase_stats.allocations, phase_stats.bytes, phase_stats.frees);
+    }
+
+#ifdef DEBUG
+    fprintf(stderr, "  call sites:\n");
+    for (CallSite &slot : g_call_sites)
+    {
+        if (slot.key.load(std::memory_order_relaxed) == 0) continue;
+
+        fprintf(stderr, "    %lu allocations, %lu bytes\n",
+                slot.allocations.load(std::memory_order_relaxed), slot.bytes.load(std::memory_order_relaxed));
+        print_address("at",   slot.site.load(std::memory_order_relaxed));
+        print_address("from", slot.parent.load(std::memory_order_relaxed));
+    }
+#endif
+}
+
+// ————— HOOKS ————— //
+void AllocationTracker::record_allocation(size_t bytes, void *site, void *parent)
+{
+    PhaseCounters &counters = g_counters[t_phase];
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+#ifdef DEBUG
+    record_call_site(bytes, site, parent);
+#else
+    (void) site;
+    (void) parent;
+#endif
+}
+
+void AllocationTracker::record_free()
+{
+    g_counters[t_phase].frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ————— GLOBAL OPERATOR NEW/DELETE ————— //
+// Apple's ABIs keep frame pointers everywhere, libc++ included, so one level
+// further up the stack is safe to read there; that's what makes the call site
+// useful when the allocation goes through std::allocator.
+#if defined(DEBUG) && defined(__APPLE__)
+#define ALLOCATION_PARENT __builtin_return_address(1)
+#else
+#define ALLOCATION_PARENT nullptr
+#endif
+
+static void* tracked_allocate(size_t bytes, void *site, void *parent)
+{
+    AllocationTracker::record_allocation(bytes, site, parent);
+    return malloc(bytes == 0 ? 1 : bytes);
+}
+
+void* operator new(size_t bytes)
+{
+    void *memory = tracked_allocate(bytes, __builtin_return_address(0), ALLOCATION_PARENT);
+    if (memory == nullptr) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new[](size_t bytes)
+{
+    void *memory = tracked_allocate(bytes, __builtin_return_address(0), ALLOCATION_PARENT);
+    if (memory == nullptr) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new(size_t bytes, const std::nothrow_t&) noexcept
+{
+    return tracked_allocate(bytes, __builtin_return_address(0), ALLOCATION_PARENT);
+}
+
+void* operator new[](size_t bytes, const std::nothrow_t&) noexcept
+{
+    return tracked_allocate(bytes, __builtin_return_address(0), ALLOCATION_PARENT);
+}
+
+void operator delete(void *memory) noexcept
+{
+    if (memory == nullptr) return;
+    AllocationTracker::record_free();
+    free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    if (memory == nullptr) return;
+    AllocationTracker::record_free();
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept   { operator delete(memory);   }
+void operator delete[](void *memory, size_t) noexcept { operator delete[](memory); }
+
+void operator delete(void *memory, const std::nothrow_t&) noexcept   { operator delete(memory);   }
+void operator delete[](void *memory, const std::nothrow_t&) noexcept { operator delete[](memory); }
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+
+// Counts every C++ heap allocation (global operator new) by frame phase, so a
+// frame that allocates shows up immediately. Allocations made straight through
+// malloc (SDL, the GL driver, stb_image) aren't seen.
+//
+// The phase is per thread: the simulation thread tags itself once, the main
+// thread switches phase as it goes through the frame. end_frame() closes the
+// books on a frame; with zero-alloc mode on, a frame that allocated at all
+// prints a report and aborts. Allocations the GL driver makes inside draw
+// calls are counted under PHASE_DRIVER and don't fail a frame.
+//
+// Debug builds (DEBUG defined) also record the call sites that allocated
+// during the frame, which the report lists with their symbol names.
+class AllocationTracker
+{
+public:
+    enum Phase { PHASE_OTHER, PHASE_INPUT, PHASE_SIMULATION, PHASE_RENDER, PHASE_DRIVER, PHASE_COUNT };
+
+    struct PhaseStats
+    {
+        unsigned long allocations = 0;
+        unsigned long bytes       = 0;
+        unsigned long frees       = 0;
+    };
+
+    struct FrameStats
+    {
+        PhaseStats phases[PHASE_COUNT];
+        PhaseStats total;
+    };
+
+    static constexpr int MAX_CALL_SITES = 256;
+
+    // ————— FRAME BOOKKEEPING ————— //
+    static void  set_phase(Phase phase);   // for the calling thread
+    static Phase get_phase();
+
+    // Call once per frame, on the main thread, after the frame is presented
+    static void end_frame();
+    static const FrameStats& get_frame_stats();  // the last frame end_frame() closed
+
+    // Fail any frame that allocates from here on; turn it on once the game
+    // has warmed up (textures loaded, first-frame uploads done)
+    static void set_zero_alloc(bool enabled);
+    static bool get_zero_alloc();
+
+    static void print_report(const FrameStats &stats);
+
+    static const char* phase_name(Phase phase);
+
+    // Switches the calling thread's phase for the scope's lifetime
+    class PhaseScope
+    {
+    private:
+        Phase m_previous;
+
+    public:
+        explicit PhaseScope(Phase phase) : m_previous(get_phase()) { set_phase(phase); }
+        ~PhaseScope() { set_phase(m_previous); }
+
+        PhaseScope(const PhaseScope&) = delete;
+        PhaseScope& operator=(const PhaseScope&) = delete;
+    };
+
+    // ————— HOOKS ————— //
+    // Called from the operator new/delete replacements; must not allocate
+    static void record_allocation(size_t bytes, void *site, void *parent);
+    static void record_free();
+};
@@ -0,0 +1,321 @@
+#include "Autopilot.h"
+#include "Map.h"
+#include "PolicyTable.h"
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+
+// ————— TUNING ————— //
+// Guidance: where the lander should be heading and how fast
+constexpr float CRUISE_CLEARANCE  = 1.0f;   // above the highest terrain on the way
+constexpr float APPROACH_SLOPE    = 2.0f;   // height allowed per unit still to go, near the pad
+constexpr float POSITION_GAIN_X   = 0.8f;   // wanted sideways speed per unit off the pad
+constexpr float POSITION_GAIN_Y   = 1.0f;
+constexpr float MAX_CRUISE_SPEED  = 1.5f;
+constexpr float MAX_CLIMB_SPEED   = 0.8f;
+constexpr float MAX_DESCENT_SPEED = 1.0f;
+constexpr float TOUCHDOWN_SPEED   = 0.25f;  // descent speed allowed right at the pad...
+constexpr float DESCENT_GAIN      = 0.6f;   // ...plus this much per unit of height left
+constexpr float TILT_GAIN         = 0.6f;   // radians of tilt per unit/s of sideways error
+constexpr float MAX_TILT          = 0.5f;
+constexpr float MAX_THRUST_ANGLE  = 1.2f;   // past this, thrust pushes more sideways than up
+constexpr float SIDEWAYS_SLACK    = 0.25f;  // units/s
+
+// Target choice: rough speeds for guessing how long a pad takes to get to
+constexpr float ESTIMATED_CRUISE_SPEED  = 1.0f;
+constexpr float ESTIMATED_CLIMB_SPEED   = 0.5f;
+constexpr float ESTIMATED_DESCENT_SPEED = 0.5f;
+
+// Rollouts
+constexpr float HORIZON_SECONDS = 1.5f;
+constexpr float COMMIT_SECONDS  = 0.15f;  // how long a candidate holds its first input
+constexpr float VELOCITY_WEIGHT = 1.0f;
+constexpr float FUEL_WEIGHT     = 0.05f;
+constexpr float TERRAIN_MARGIN  = 0.4f;
+constexpr float TERRAIN_WEIGHT  = 40.0f;
+constexpr float LANDING_WEIGHT  = 2.0f;
+constexpr float TERMINAL_WEIGHT = 0.5f;
+constexpr float CRASH_COST      = 1.0e6f;
+
+constexpr int CANDIDATE_COUNT = 8;
+
+constexpr float Autopilot::DEFAULT_BUDGET_MILLISECONDS;
+
+static float clamp(float value, float low, float high) { return std::max(low, std::min(high, value)); }
+
+Autopilot::Autopilot(const Map *map, float lander_width, float lander_height)
+    : m_map(map), m_half_width(lander_width / 2.0f), m_half_height(lander_height / 2.0f)
+{
+    survey();
+}
+
+void Autopilot::survey()
+{
+    const unsigned int *level = m_map->get_level_data();
+    int   width     = m_map->get_width();
+    int   height    = m_map->get_height();
+    float tile_size = m_map->get_tile_size();
+
+    m_surface.assign(width, -height * tile_size);
+    for (int x = 0; x < width; x++)
+    {
+        for (int y = 0; y < height; y++)
+        {
+            if (level[y * width + x] == 0) continue;
+            m_surface[x] = -y * tile_size;
+            break;
+        }
+    }
+
+    // A pad is any run of pad tiles along a row that are each the top of
+    // their column, so the lander can come straight down onto them
+    m_pads.clear();
+    m_target = -1;
+    for (int y = 0; y < height; y++)
+    {
+        int x = 0;
+        while (x < width)
+        {
+            int run = 0;
+            while (x + run < width && level[y * width + x + run] == Map::LANDING_PAD_TILE &&
+                   m_surface[x + run] == -y * tile_size)
+            {
+                run++;
+            }
+            if (run == 0) { x++; continue; }
+
+            Pad pad;
+            pad.x          = (x + run * 0.5f) * tile_size;
+            pad.y          = -y * tile_size;
+            pad.half_width = run * tile_size * 0.5f;
+            pad.tile_x     = x;
+            pad.tile_y     = y;
+            pad.tile_count = run;
+            m_pads.push_back(pad);
+
+            x += run;
+        }
+    }
+}
+
+// How high to fly to clear everything between two x positions
+float Autopilot::cruise_height(float from_x, float to_x) const
+{
+    float inverse_tile_size = 1.0f / m_map->get_tile_size();
+    int first = std::max((int) floorf(std::min(from_x, to_x) * inverse_tile_size) - 1, 0);
+    int last  = std::min((int) floorf(std::max(from_x, to_x) * inverse_tile_size) + 1, (int) m_surface.size() - 1);
+
+    float highest = m_map->get_bottom_bound();
+    for (int x = first; x <= last; x++) highest = std::max(highest, m_surface[x]);
+    return highest + CRUISE_CLEARANCE * m_map->get_tile_size() + m_half_height;
+}
+
+int Autopilot::best_pad(const LanderState &state) const
+{
+    constexpr float HOVER_DUTY = -LanderPhysics::GRAVITY / LanderPhysics::THRUST_ACCELERATION;
+
+    int   best = -1, best_affordable = -1;
+    float best_time = INFINITY, best_affordable_time = INFINITY;
+
+    for (int i = 0; i < (int) m_pads.size(); i++)
+    {
+        const Pad &pad = m_pads[i];
+        float cruise = cruise_height(state.x, pad.x);
+
+        float time = fabsf(pad.x - state.x) / ESTIMATED_CRUISE_SPEED
+                   + std::max(0.0f, cruise - state.y) / ESTIMATED_CLIMB_SPEED
+                   + (std::max(cruise, state.y) - pad.y) / ESTIMATED_DESCENT_SPEED;
+        float fuel = time * HOVER_DUTY * LanderPhysics::FUEL_BURN_RATE;
+
+        if (time < best_time) { best = i; best_time = time; }
+        if (fuel <= state.fuel && time < best_affordable_time) { best_affordable = i; best_affordable_time = time; }
+    }
+
+    return best_affordable >= 0 ? best_affordable : best;
+}
+
+// Far from the pad, hold cruise height; closer in, the allowed height drops
+// away along an approach slope down to touchdown
+Autopilot::Guidance Autopilot::guide(const LanderState &state, const Pad &pad) const
+{
+    float offset_x  = pad.x - state.x;
+    float landing_y = pad.y + m_half_height;
+
+    float slack  = std::max(0.0f, fabsf(offset_x) - pad.half_width * 0.5f);
+    float target = std::min(cruise_height(state.x, pad.x), landing_y + APPROACH_SLOPE * slack);
+
+    Guidance guidance;
+    guidance.velocity_x = clamp(offset_x * POSITION_GAIN_X, -MAX_CRUISE_SPEED, MAX_CRUISE_SPEED);
+    guidance.velocity_y = clamp((target - state.y) * POSITION_GAIN_Y, -MAX_DESCENT_SPEED, MAX_CLIMB_SPEED);
+
+    // Ease off the descent as the pad comes up
+    float gentlest = -(TOUCHDOWN_SPEED + DESCENT_GAIN * (state.y - landing_y));
+    guidance.velocity_y = std::min(std::max(guidance.velocity_y, gentlest), MAX_CLIMB_SPEED);
+
+    guidance.angle = clamp(TILT_GAIN * (guidance.velocity_x - state.velocity_x), -MAX_TILT, MAX_TILT);
+    return guidance;
+}
+
+// The PD part: level out around the wanted tilt, thrust while too slow
+LanderInput Autopilot::follow(const LanderState &state, const Guidance &guidance) const
+{
+    LanderState relative = state;
+    relative.angle = LanderPhysics::wrap_angle(state.angle - guidance.angle);
+
+    float sideways_error = fabsf(guidance.velocity_x - state.velocity_x);
+
+    LanderInput input;
+    input.torque = LanderPhysics::levelling_torque(relative);
+    input.thrust = fabsf(state.angle) < MAX_THRUST_ANGLE &&
+                   (state.velocity_y < guidance.velocity_y ||
+                    (sideways_error > SIDEWAYS_SLACK && state.velocity_y < guidance.velocity_y + SIDEWAYS_SLACK));
+    return input;
+}
+
+// The same four probes Systems::collide makes: what the lander is touching, if anything
+int Autopilot::touching_tile(const LanderState &state) const
+{
+    float inverse_tile_size = 1.0f / m_map->get_tile_size();
+    const float xs[4] = { state.x, state.x - m_half_width, state.x + m_half_width, state.x };
+    const float ys[4] = { state.y - m_half_height, state.y, state.y, state.y + m_half_height };
+
+    for (int i = 0; i < 4; i++)
+    {
+        int tile = m_map->get_tile_type((int) floorf(xs[i] * inverse_tile_size),
+                                        (int) floorf(-ys[i] * inverse_tile_size));
+        if (tile > 0) return tile;
+    }
+    return 0;
+}
+
+// What the policy table would do here, or the PD controller where the table
+// doesn't know a landing the fuel covers
+LanderInput Autopilot::consult_policy(const LanderState &state, const Pad &pad, const Guidance &guidance) const
+{
+    PolicyTable::Entry entry = m_policy->lookup(state, pad.x, pad.y);
+    if (entry.landable && entry.fuel <= state.fuel) return PolicyTable::to_input(entry, state);
+    return follow(state, guidance);
+}
+
+// Cost of flying `first` for a moment and then the PD controller (or the
+// policy table) to the end of the horizon. Gives up early once the cost
+// passes give_up_at, since the caller already has something cheaper.
+float Autopilot::rollout(LanderState state, const LanderInput &first, float delta_time, float give_up_at,
+                         bool by_policy) const
+{
+    const Pad &pad = m_pads[m_target];
+    const float top    = m_map->get_top_bound();
+    const float bottom = m_map->get_bottom_bound();
+    const float extent = std::max(m_half_width, m_half_height);
+
+    int steps        = std::max(1, (int) (HORIZON_SECONDS / delta_time));
+    int commit_steps = std::max(1, (int) (COMMIT_SECONDS / delta_time));
+
+    float cost = 0.0f;
+    for (int step = 0; step < steps; step++)
+    {
+        Guidance guidance = guide(state, pad);
+        LanderInput input = step < commit_steps ? first
+                          : by_policy         ? consult_policy(state, pad, guidance)
+                          :                     follow(state, guidance);
+        LanderPhysics::integrate(state, input, delta_time);
+
+        float error_x = state.velocity_x - guidance.velocity_x;
+        float error_y = state.velocity_y - guidance.velocity_y;
+        cost += (error_x * error_x + error_y * error_y) * VELOCITY_WEIGHT * delta_time;
+        if (input.thrust && state.fuel > 0.0f) cost += FUEL_WEIGHT * delta_time;
+
+        // The field only covers the map; above it, add the height over the top.
+        // Straight over the pad, the ground coming up is the point.
+        glm::vec3 position(state.x, state.y, 0.0f);
+        float clearance = m_map->solid_distance(position) + std::max(0.0f, state.y - top) - extent;
+        bool  over_pad  = fabsf(state.x - pad.x) < pad.half_width && state.y > pad.y;
+        if (clearance < TERRAIN_MARGIN && !over_pad)
+        {
+            cost += (TERRAIN_MARGIN - clearance) * (TERRAIN_MARGIN - clearance) * TERRAIN_WEIGHT * delta_time;
+        }
+
+        int tile = touching_tile(state);
+        if (tile == (int) Map::LANDING_PAD_TILE)
+        {
+            return cost + LANDING_WEIGHT * (state.velocity_x * state.velocity_x +
+                                            state.velocity_y * state.velocity_y +
+                                            state.angle * state.angle);
+        }
+        if (tile > 0 || state.y < bottom) return cost + CRASH_COST;
+
+        if (cost >= give_up_at) return cost;
+    }
+
+    float offset_x = pad.x - state.x;
+    float offset_y = pad.y + m_half_height - state.y;
+    return cost + TERMINAL_WEIGHT * (offset_x * offset_x + offset_y * offset_y);
+}
+
+LanderInput Autopilot::update(const LanderState &state, float delta_time)
+{
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+
+    m_stats = Stats();
+    if (m_target < 0 && choose_target(state) < 0)
+    {
+        // Nowhere to land; just stay upright
+        LanderInput input;
+        input.torque = LanderPhysics::levelling_torque(state);
+        return input;
+    }
+
+    const Pad &pad = m_pads[m_target];
+
+    // The table's fuel-minimal landing wins outright, as long as flying it
+    // doesn't run into the real terrain (the table assumes flat ground)
+    if (m_policy != nullptr)
+    {
+        PolicyTable::Entry entry = m_policy->lookup(state, pad.x, pad.y);
+        if (entry.landable && entry.fuel <= state.fuel)
+        {
+            LanderInput input = PolicyTable::to_input(entry, state);
+            float cost = rollout(state, input, delta_time, INFINITY, true);
+            m_stats.rollouts     = 1;
+            m_stats.milliseconds = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+            if (cost < CRASH_COST) return input;
+        }
+    }
+
+    LanderInput proposal = follow(state, guide(state, pad));
+
+    // The PD proposal first, then its opposite thrust, then every bang-bang combination
+    LanderInput candidates[CANDIDATE_COUNT];
+    candidates[0] = proposal;
+    candidates[1] = proposal;
+    candidates[1].thrust = !proposal.thrust;
+    for (int i = 2; i < CANDIDATE_COUNT; i++)
+    {
+        candidates[i].torque = (float) ((i - 2) / 2 - 1);
+        candidates[i].thrust = (i & 1) != 0;
+    }
+
+    LanderInput chosen    = proposal;
+    float       best_cost = INFINITY;
+    float       elapsed   = std::chrono::duration<float>(Clock::now() - start).count();
+
+    for (int i = 0; i < CANDIDATE_COUNT; i++)
+    {
+        // Stop before a rollout that probably wouldn't finish in time
+        if (m_stats.rollouts > 0 && elapsed + elapsed / m_stats.rollouts > m_budget_seconds) break;
+
+        float cost = rollout(state, candidates[i], delta_time, best_cost, false);
+        if (cost < best_cost)
+        {
+            best_cost = cost;
+            chosen    = candidates[i];
+        }
+
+        m_stats.rollouts++;
+        elapsed = std::chrono::duration<float>(Clock::now() - start).count();
+    }
+
+    m_stats.milliseconds = elapsed * 1000.0f;
+    return chosen;
+}
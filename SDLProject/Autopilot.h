@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+#include "LanderPhysics.h"
+
+class Map;
+class PolicyTable;
+
+// Flies a lander onto the nearest landing pad it can reach. Each step a PD
+// controller proposes an input (tilt towards the speed it wants, thrust
+// whenever it's sinking faster than it wants), and a handful of alternatives
+// to that first input get rolled forward a second or so through the real
+// flight model against the map. Whichever rollout scores best is what gets
+// flown this step.
+//
+// With a PolicyTable loaded, the table's fuel-minimal input is flown instead
+// wherever it knows a landing the fuel covers and a rollout of it (table all
+// the way down) doesn't hit the real terrain, which the table can't see.
+//
+// Rollouts stop once the per-step time budget is spent, and the proposal
+// always goes first, so a tight budget degrades to flying the proposal as
+// is rather than to nothing. Nothing allocates after construction.
+class Autopilot
+{
+public:
+    // The top surface of a run of pad tiles with open sky straight above it
+    struct Pad
+    {
+        float x, y;        // middle of the top edge, world units
+        float half_width;
+        int   tile_x, tile_y, tile_count;
+    };
+
+    // What the last update cost
+    struct Stats
+    {
+        int   rollouts     = 0;
+        float milliseconds = 0.0f;
+    };
+
+    static constexpr float DEFAULT_BUDGET_MILLISECONDS = 0.5f;
+
+private:
+    const Map         *m_map;
+    const PolicyTable *m_policy = nullptr;
+    float m_half_width, m_half_height;
+    float m_budget_seconds = DEFAULT_BUDGET_MILLISECONDS / 1000.0f;
+
+    std::vector<Pad>   m_pads;
+    std::vector<float> m_surface;  // top of the highest solid tile per column
+    int m_target = -1;
+
+    Stats m_stats;
+
+    struct Guidance { float velocity_x, velocity_y, angle; };
+
+    Guidance    guide(const LanderState &state, const Pad &pad) const;
+    LanderInput follow(const LanderState &state, const Guidance &guidance) const;
+    float       cruise_height(float from_x, float to_x) const;
+    int         touching_tile(const LanderState &state) const;
+    LanderInput consult_policy(const LanderState &state, const Pad &pad, const Guidance &guidance) const;
+    float       rollout(LanderState state, const LanderInput &first, float delta_time, float give_up_at,
+                        bool by_policy) const;
+
+public:
+    Autopilot(const Map *map, float lander_width, float lander_height);
+
+    // Re-reads the map for pads and terrain heights; call after it changes
+    void survey();
+
+    // The pad to head for: the quickest one to get to that the fuel should
+    // cover, or the quickest of all if none is. -1 when there are no pads.
+    int best_pad(const LanderState &state) const;
+    int choose_target(const LanderState &state) { return m_target = best_pad(state); }
+
+    // Forget the current pad, so the next update picks again
+    void reset() { m_target = -1; }
+
+    // The input to fly for the next delta_time
+    LanderInput update(const LanderState &state, float delta_time);
+
+    void set_budget(float milliseconds) { m_budget_seconds = milliseconds / 1000.0f; }
+    void set_policy(const PolicyTable *policy) { m_policy = policy; }
+
+    const std::vector<Pad>& get_pads() const { return m_pads; }
+    const Pad* get_target() const { return m_target >= 0 ? &m_pads[m_target] : nullptr; }
+    const Stats& get_stats() const { return m_stats; }
+};
@@ -0,0 +1,79 @@
+#pragma once
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include "LanderPhysics.h"
+
+class Autopilot;
+
+// Plain-data components for World. Each one lives in its own packed array,
+// so a system only pulls in the fields it reads: physics never sees a
+// texture, and drawing never sees fuel.
+
+enum Animation { IDLE, ATTACK, ANIMATION_COUNT };
+
+// ————— HOT: every physics step ————— //
+struct Transform
+{
+    float x = 0.0f, y = 0.0f;
+    float angle = 0.0f;  // radians, clockwise from up
+};
+
+struct Velocity
+{
+    float x = 0.0f, y = 0.0f;
+    float angular = 0.0f;  // radians per second, clockwise
+};
+
+// An axis-aligned box round the Transform. Anything with a Collider but no
+// Velocity is a static obstacle that movers stop against.
+struct Collider
+{
+    float width = 1.0f, height = 1.0f;
+
+    // Which sides touched something this step
+    bool top = false, bottom = false, left = false, right = false;
+
+    // Set by the first thing that ends the flight, along with the tile that
+    // did it when it was the map. Nothing moves a finished collider again.
+    bool finished     = false;
+    int  touched_tile = 0;
+};
+
+struct Fuel
+{
+    float amount  = 500.0f;
+    bool  burning = false;  // thrust actually fired this step
+};
+
+// Whoever is flying: the input the keys (or the AI system, while an
+// autopilot is engaged) asked for this step
+struct AI
+{
+    LanderInput input;
+    Autopilot  *autopilot = nullptr;
+    bool        engaged   = false;
+};
+
+// ————— COLD: only for drawing ————— //
+struct Sprite
+{
+    // Everything needed to draw one, captured on the simulation side so
+    // another thread can draw it without touching the world
+    struct RenderState
+    {
+        float  x = 0.0f, y = 0.0f;
+        float  rotation = 0.0f;  // degrees, clockwise
+        float  scale_x = 1.0f, scale_y = 1.0f;
+        GLuint texture_id = 0;
+        float  u = 0.0f, v = 0.0f, width = 1.0f, height = 1.0f;  // atlas rect
+    };
+
+    GLuint    texture_ids[ANIMATION_COUNT] = { 0, 0 };  // a sheet per animation
+    Animation animation = IDLE;
+    int       columns = 1, rows = 1;  // frames across and down each sheet
+    int       frame   = 0;
+    float     scale_x = 1.0f, scale_y = 1.0f;
+};
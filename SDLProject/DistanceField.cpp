@@ -0,0 +1,126 @@
+#include "DistanceField.h"
+#include <math.h>
+#include <algorithm>
+
+// Stands in for "no feature" during the transform; squares of real distances
+// stay far below it, and FAR is what comes out the other end
+static const float NONE = 1.0e20f;
+
+constexpr float DistanceField::FAR;
+
+void DistanceField::build(const unsigned int *level, int width, int height, FeatureTest is_feature)
+{
+    m_width      = width;
+    m_height     = height;
+    m_is_feature = is_feature;
+
+    m_column.assign(width * height, NONE);
+    m_distance.assign(width * height, FAR);
+    m_scratch.assign(height, 0.0f);
+    m_hull.assign(width, 0);
+    m_boundaries.assign(width + 1, 0.0f);
+
+    // The column pass for every column at once, a row at a time so it walks
+    // memory in order: down, then back up, then square
+    float *column = m_column.data();
+    for (int y = 0; y < height; y++)
+    {
+        const float *above = y > 0 ? &column[(y - 1) * width] : nullptr;
+        for (int x = 0; x < width; x++)
+        {
+            float distance = above ? above[x] + 1.0f : NONE;
+            column[y * width + x] = is_feature(level[y * width + x]) ? 0.0f : distance;
+        }
+    }
+    for (int y = height - 2; y >= 0; y--)
+    {
+        const float *below = &column[(y + 1) * width];
+        for (int x = 0; x < width; x++) column[y * width + x] = std::min(column[y * width + x], below[x] + 1.0f);
+    }
+    for (float &cell : m_column) cell = cell >= NONE * 0.5f ? NONE : cell * cell;
+
+    for (int y = 0; y < height; y++) row_pass(y);
+}
+
+// Squared distance to the nearest feature above or below, two sweeps
+void DistanceField::column_pass(const unsigned int *level, int x, float *out) const
+{
+    float distance = NONE;
+    for (int y = 0; y < m_height; y++)
+    {
+        distance = m_is_feature(level[y * m_width + x]) ? 0.0f : distance + 1.0f;
+        out[y] = distance;
+    }
+
+    distance = NONE;
+    for (int y = m_height - 1; y >= 0; y--)
+    {
+        distance = out[y] == 0.0f ? 0.0f : distance + 1.0f;
+        float nearest = std::min(out[y], distance);
+        out[y] = nearest >= NONE * 0.5f ? NONE : nearest * nearest;
+    }
+}
+
+// Lower envelope of the parabolas (x - q)^2 + column(q), read off at each x
+void DistanceField::row_pass(int y)
+{
+    const float *column = &m_column[y * m_width];
+    int   *hull       = m_hull.data();
+    float *boundaries = m_boundaries.data();
+
+    int k = 0;
+    hull[0]       = 0;
+    boundaries[0] = -INFINITY;
+    boundaries[1] =  INFINITY;
+
+    for (int q = 1; q < m_width; q++)
+    {
+        // Where parabola q overtakes the last one on the hull; drop any it buries
+        float s;
+        while (true)
+        {
+            int v = hull[k];
+            s = ((column[q] + (float) (q * q)) - (column[v] + (float) (v * v))) / (float) (2 * q - 2 * v);
+            if (s > boundaries[k]) break;
+            k--;
+        }
+
+        k++;
+        hull[k]           = q;
+        boundaries[k]     = s;
+        boundaries[k + 1] = INFINITY;
+    }
+
+    float *distance = &m_distance[y * m_width];
+    k = 0;
+    for (int x = 0; x < m_width; x++)
+    {
+        while (boundaries[k + 1] < (float) x) k++;
+
+        int   v = hull[k];
+        float squared = (float) ((x - v) * (x - v)) + column[v];
+        distance[x] = squared >= NONE * 0.5f ? FAR : sqrtf(squared);
+    }
+}
+
+void DistanceField::update_tile(const unsigned int *level, int x, int y)
+{
+    if (!is_built() || x < 0 || x >= m_width || y < 0 || y >= m_height) return;
+
+    // Redo the tile's column and find which rows of it actually changed...
+    column_pass(level, x, m_scratch.data());
+
+    int first = m_height, last = -1;
+    for (int row = 0; row < m_height; row++)
+    {
+        float &cell = m_column[row * m_width + x];
+        if (cell == m_scratch[row]) continue;
+
+        cell  = m_scratch[row];
+        first = std::min(first, row);
+        last  = row;
+    }
+
+    // ...and only those rows need their envelope rebuilt
+    for (int row = first; row <= last; row++) row_pass(row);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+// Exact Euclidean distance, in tiles, from every tile centre to the nearest
+// "feature" tile (solid, empty, landing pad... whatever the predicate says).
+//
+// Built with the two-pass transform of Felzenszwalb & Huttenlocher: a 1D pass
+// down each column, then a lower envelope of parabolas along each row, both
+// linear in the number of tiles. The column pass is kept, so when one tile
+// changes only its column is redone, plus the rows whose column value moved.
+class DistanceField
+{
+public:
+    typedef bool (*FeatureTest)(unsigned int tile);
+
+private:
+    int m_width  = 0;
+    int m_height = 0;
+    FeatureTest m_is_feature = nullptr;
+
+    std::vector<float> m_column;    // squared distance to the nearest feature in the same column
+    std::vector<float> m_distance;  // the result
+
+    // Scratch for the row pass and column updates, sized once
+    std::vector<float> m_scratch;
+    std::vector<int>   m_hull;
+    std::vector<float> m_boundaries;
+
+    void column_pass(const unsigned int *level, int x, float *out) const;
+    void row_pass(int y);
+
+public:
+    // Beyond every real distance; what tiles get when there are no features
+    static constexpr float FAR = 1.0e10f;
+
+    DistanceField() { }
+
+    void build(const unsigned int *level, int width, int height, FeatureTest is_feature);
+
+    // Call after level[y * width + x] changed
+    void update_tile(const unsigned int *level, int x, int y);
+
+    bool  const is_built() const { return m_width > 0; }
+    float const get(int x, int y) const { return m_distance[y * m_width + x]; }
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <math.h>
+
+// Sine and cosine together, for the physics and sprite hot paths.
+//
+// The angle is folded into [-pi/4, pi/4] around the nearest multiple of pi/2
+// (pi/2 split in two parts so the reduction stays exact for a few thousand
+// radians), then both come from short minimax polynomials. Absolute error is
+// under 2e-7 across that range, i.e. as good as sinf/cosf for anything a
+// lander will ever be rotated by, with no table and no branches (the quadrant
+// fix-up is all selects).
+inline void fast_sincos(float radians, float *sine, float *cosine)
+{
+    const float TWO_OVER_PI  = 0.636619772f;
+    const float PI_OVER_2_HI = 1.5703125f;         // exact in 8 bits
+    const float PI_OVER_2_LO = 4.83826794897e-4f;  // pi/2 - PI_OVER_2_HI
+
+    // Round to nearest by hand; nearbyintf is a library call on some targets
+    float scaled   = radians * TWO_OVER_PI;
+    int   quadrant = (int) (scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+
+    float r  = (radians - quadrant * PI_OVER_2_HI) - quadrant * PI_OVER_2_LO;
+    float r2 = r * r;
+
+    float s = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+    float c = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f
+                                 + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+
+    // Odd quadrants swap sine and cosine; the sign pattern repeats every four
+    bool  swap          = (quadrant & 1) != 0;
+    float sine_sign     = (quadrant & 2)       ? -1.0f : 1.0f;
+    float cosine_sign   = ((quadrant + 1) & 2) ? -1.0f : 1.0f;
+
+    *sine   = sine_sign   * (swap ? c : s);
+    *cosine = cosine_sign * (swap ? s : c);
+}
+
+inline float fast_sin(float radians) { float s, c; fast_sincos(radians, &s, &c); return s; }
+inline float fast_cos(float radians) { float s, c; fast_sincos(radians, &s, &c); return c; }
@@ -0,0 +1,66 @@
+#include "FrameScheduler.h"
+#include <thread>
+
+FrameScheduler::FrameScheduler()
+    : m_frequency(SDL_GetPerformanceFrequency())
+{
+    m_last_frame = SDL_GetPerformanceCounter();
+}
+
+bool FrameScheduler::set_vsync(bool enabled)
+{
+    bool accepted = SDL_GL_SetSwapInterval(enabled ? 1 : 0) == 0;
+    m_vsync = enabled && accepted;
+    return accepted;
+}
+
+void FrameScheduler::set_target_rate(float frames_per_second)
+{
+    m_ticks_per_frame = frames_per_second > 0.0f ? (Uint64) (m_frequency / frames_per_second) : 0;
+    m_next_deadline   = SDL_GetPerformanceCounter() + m_ticks_per_frame;
+}
+
+void FrameScheduler::sleep_until(Uint64 deadline)
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    // Coarse phase: let the OS have the core for all but the spin margin
+    double remaining = now < deadline ? to_seconds(deadline - now) : 0.0;
+    if (remaining > m_spin_margin_seconds)
+    {
+        Uint32 sleep_ms = (Uint32) ((remaining - m_spin_margin_seconds) * 1000.0);
+
+        if (sleep_ms > 0)
+        {
+            Uint64 before = SDL_GetPerformanceCounter();
+            SDL_Delay(sleep_ms);
+            double overslept = to_seconds(SDL_GetPerformanceCounter() - before) - sleep_ms / 1000.0;
+
+            // Follow the scheduler's recent behaviour so we neither wake late nor spin long
+            m_spin_margin_seconds = 0.9 * m_spin_margin_seconds + 0.1 * (overslept + MIN_SPIN_MARGIN);
+            if (m_spin_margin_seconds < MIN_SPIN_MARGIN) m_spin_margin_seconds = MIN_SPIN_MARGIN;
+            if (m_spin_margin_seconds > MAX_SPIN_MARGIN) m_spin_margin_seconds = MAX_SPIN_MARGIN;
+        }
+    }
+
+    // Fine phase: yield-spin the last fraction of a millisecond
+    while (SDL_GetPerformanceCounter() < deadline) std::this_thread::yield();
+}
+
+void FrameScheduler::wait_for_next_frame()
+{
+    if (m_ticks_per_frame != 0)
+    {
+        Uint64 now = SDL_GetPerformanceCounter();
+
+        // Fell more than a frame behind (a hitch, a breakpoint): don't try to catch up
+        if (now > m_next_deadline + m_ticks_per_frame) m_next_deadline = now;
+        else sleep_until(m_next_deadline);
+
+        m_next_deadline += m_ticks_per_frame;
+    }
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    m_frame_seconds = (float) to_seconds(now - m_last_frame);
+    m_last_frame    = now;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <SDL.h>
+
+// Paces the main loop. With vsync the swap itself blocks; otherwise (or on
+// top of it, when a cap is set) each frame waits until its deadline by
+// sleeping for most of the remaining time and spinning for the last stretch,
+// since SDL_Delay can overshoot by a millisecond or more.
+class FrameScheduler
+{
+private:
+    Uint64 m_frequency;
+    Uint64 m_ticks_per_frame = 0;  // 0 means uncapped
+    Uint64 m_next_deadline   = 0;
+    Uint64 m_last_frame      = 0;
+
+    bool  m_vsync = false;
+    float m_frame_seconds = 0.0f;
+
+    // How early to wake from sleep before a deadline; tracks observed oversleep
+    double m_spin_margin_seconds = 0.002;
+
+    static constexpr double MIN_SPIN_MARGIN = 0.0005,
+                            MAX_SPIN_MARGIN = 0.004;
+
+    double to_seconds(Uint64 ticks) const { return (double) ticks / (double) m_frequency; }
+    void sleep_until(Uint64 deadline);
+
+public:
+    FrameScheduler();
+
+    // Returns whether the driver accepted the swap interval
+    bool set_vsync(bool enabled);
+    // Frames per second to cap at; 0 leaves the rate to vsync (or unlimited)
+    void set_target_rate(float frames_per_second);
+
+    // Call once per frame, after the buffer swap
+    void wait_for_next_frame();
+
+    bool  const get_vsync()         const { return m_vsync; }
+    float const get_frame_seconds() const { return m_frame_seconds; }
+    float const get_target_rate()   const
+    {
+        return m_ticks_per_frame == 0 ? 0.0f : (float) m_frequency / (float) m_ticks_per_frame;
+    }
+};
@@ -0,0 +1,196 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "GLState.h"
+#include "AllocationTracker.h"
+
+// These match the defaults of a freshly created context
+GLuint   GLState::s_program_id          = 0;
+GLuint   GLState::s_vertex_array        = 0;
+GLuint   GLState::s_array_buffer        = 0;
+int      GLState::s_active_texture_unit = 0;
+GLuint   GLState::s_textures[GLState::MAX_TEXTURE_UNITS] = { 0 };
+unsigned GLState::s_enabled_attributes  = 0;
+
+bool   GLState::s_blend_enabled     = false;
+GLenum GLState::s_blend_source      = GL_ONE;
+GLenum GLState::s_blend_destination = GL_ZERO;
+
+GLState::FrameStats GLState::s_frame_stats;
+
+void GLState::reset()
+{
+    s_program_id          = 0;
+    s_vertex_array        = 0;
+    s_array_buffer        = 0;
+    s_active_texture_unit = 0;
+    for (int i = 0; i < MAX_TEXTURE_UNITS; i++) s_textures[i] = 0;
+    s_enabled_attributes  = 0;
+
+    s_blend_enabled     = false;
+    s_blend_source      = GL_ONE;
+    s_blend_destination = GL_ZERO;
+}
+
+bool GLState::use_program(GLuint program_id)
+{
+    if (s_program_id == program_id)
+    {
+        s_frame_stats.calls_elided++;
+        return false;
+    }
+
+    glUseProgram(program_id);
+    s_program_id = program_id;
+    s_frame_stats.calls_issued++;
+
+    return true;
+}
+
+void GLState::active_texture(int unit)
+{
+    if (s_active_texture_unit == unit) return;
+
+    glActiveTexture(GL_TEXTURE0 + unit);
+    s_active_texture_unit = unit;
+    s_frame_stats.calls_issued++;
+}
+
+void GLState::bind_texture(GLuint texture_id, int unit)
+{
+    if (s_textures[unit] == texture_id)
+    {
+        s_frame_stats.calls_elided++;
+        return;
+    }
+
+    active_texture(unit);
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+    s_textures[unit] = texture_id;
+
+    s_frame_stats.calls_issued++;
+    s_frame_stats.texture_binds++;
+}
+
+void GLState::bind_array_buffer(GLuint buffer_id)
+{
+    if (s_array_buffer == buffer_id)
+    {
+        s_frame_stats.calls_elided++;
+        return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
+    s_array_buffer = buffer_id;
+    s_frame_stats.calls_issued++;
+}
+
+void GLState::delete_buffer(GLuint buffer_id)
+{
+    // Deleting a bound buffer silently rebinds zero
+    if (s_array_buffer == buffer_id) s_array_buffer = 0;
+    glDeleteBuffers(1, &buffer_id);
+}
+
+#ifndef USE_LEGACY_GL
+void GLState::bind_vertex_array(GLuint vertex_array_id)
+{
+    if (s_vertex_array == vertex_array_id)
+    {
+        s_frame_stats.calls_elided++;
+        return;
+    }
+
+    glBindVertexArray(vertex_array_id);
+    s_vertex_array = vertex_array_id;
+    s_frame_stats.calls_issued++;
+}
+
+void GLState::delete_vertex_array(GLuint vertex_array_id)
+{
+    if (s_vertex_array == vertex_array_id) s_vertex_array = 0;
+    glDeleteVertexArrays(1, &vertex_array_id);
+}
+#endif
+
+void GLState::enable_attribute(GLuint attribute)
+{
+    if (attribute >= MAX_VERTEX_ATTRIBUTES) return;
+
+    unsigned bit = 1u << attribute;
+
+    if ((s_enabled_attributes & bit))
+    {
+        s_frame_stats.calls_elided++;
+        return;
+    }
+
+    glEnableVertexAttribArray(attribute);
+    s_enabled_attributes |= bit;
+    s_frame_stats.calls_issued++;
+}
+
+void GLState::disable_attribute(GLuint attribute)
+{
+    if (attribute >= MAX_VERTEX_ATTRIBUTES) return;
+
+    unsigned bit = 1u << attribute;
+
+    if (!(s_enabled_attributes & bit))
+    {
+        s_frame_stats.calls_elided++;
+        return;
+    }
+
+    glDisableVertexAttribArray(attribute);
+    s_enabled_attributes &= ~bit;
+    s_frame_stats.calls_issued++;
+}
+
+void GLState::set_blend(bool enabled, GLenum source, GLenum destination)
+{
+    if (enabled != s_blend_enabled)
+    {
+        if (enabled) glEnable(GL_BLEND);
+        else         glDisable(GL_BLEND);
+
+        s_blend_enabled = enabled;
+        s_frame_stats.calls_issued++;
+    }
+    else
+    {
+        s_frame_stats.calls_elided++;
+    }
+
+    if (!enabled) return;
+
+    if (source != s_blend_source || destination != s_blend_destination)
+    {
+        glBlendFunc(source, destination);
+
+        s_blend_source      = source;
+        s_blend_destination = destination;
+        s_frame_stats.calls_issued++;
+    }
+    else
+    {
+        s_frame_stats.calls_elided++;
+    }
+}
+
+// Drivers compile and validate lazily at draw time, sometimes through the
+// app's operator new; that's theirs, not a frame allocation of ours
+void GLState::draw_arrays(GLenum mode, GLint first, GLsizei count)
+{
+    AllocationTracker::PhaseScope driver(AllocationTracker::PHASE_DRIVER);
+    glDrawArrays(mode, first, count);
+    s_frame_stats.draw_calls++;
+}
+
+#ifndef USE_LEGACY_GL
+void GLState::draw_arrays_instanced(GLenum mode, GLint first, GLsizei count, GLsizei instance_count)
+{
+    AllocationTracker::PhaseScope driver(AllocationTracker::PHASE_DRIVER);
+    glDrawArraysInstanced(mode, first, count, instance_count);
+    s_frame_stats.draw_calls++;
+}
+#endif
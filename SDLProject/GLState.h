@@ -0,0 +1,77 @@
+#pragma once
+#define GL_SILENCE_DEPRECATION
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#if defined(__APPLE__) && !defined(USE_LEGACY_GL)
+// Vertex array objects are only declared in the core-profile header on macOS
+#define GL_DO_NOT_WARN_IF_MULTI_GL_VERSION_HEADERS_INCLUDED
+#include <OpenGL/gl3.h>
+#endif
+#include <SDL_opengl.h>
+
+// Shadow copy of the GL state the renderer touches. Every draw path binds
+// programs, textures, buffers and attributes through here, so a call that
+// would leave the driver's state unchanged never reaches the driver.
+class GLState
+{
+public:
+    static constexpr int MAX_TEXTURE_UNITS      = 8;
+    static constexpr int MAX_VERTEX_ATTRIBUTES  = 16;
+
+    struct FrameStats
+    {
+        int calls_issued  = 0;
+        int calls_elided  = 0;
+        int texture_binds = 0;
+        int draw_calls    = 0;
+    };
+
+private:
+    static GLuint   s_program_id;
+    static GLuint   s_vertex_array;
+    static GLuint   s_array_buffer;
+    static int      s_active_texture_unit;
+    static GLuint   s_textures[MAX_TEXTURE_UNITS];
+    static unsigned s_enabled_attributes;  // bit i set when attribute i is enabled on VAO 0
+
+    static bool   s_blend_enabled;
+    static GLenum s_blend_source, s_blend_destination;
+
+    static FrameStats s_frame_stats;
+
+    static void active_texture(int unit);
+
+public:
+    // ————— BINDINGS ————— //
+    static bool use_program(GLuint program_id);
+    static void bind_texture(GLuint texture_id, int unit = 0);
+    static void bind_array_buffer(GLuint buffer_id);
+    static void delete_buffer(GLuint buffer_id);
+#ifndef USE_LEGACY_GL
+    static void bind_vertex_array(GLuint vertex_array_id);
+    static void delete_vertex_array(GLuint vertex_array_id);
+#endif
+
+    // ————— VERTEX ATTRIBUTES ————— //
+    // Only meaningful for the default vertex array; VAOs carry their own enables
+    static void enable_attribute(GLuint attribute);
+    static void disable_attribute(GLuint attribute);
+
+    // ————— BLENDING ————— //
+    static void set_blend(bool enabled, GLenum source = GL_SRC_ALPHA,
+                          GLenum destination = GL_ONE_MINUS_SRC_ALPHA);
+
+    // ————— DRAWING ————— //
+    static void draw_arrays(GLenum mode, GLint first, GLsizei count);
+#ifndef USE_LEGACY_GL
+    static void draw_arrays_instanced(GLenum mode, GLint first, GLsizei count, GLsizei instance_count);
+#endif
+
+    // Forget everything we think we know, e.g. after a context is (re)created
+    static void reset();
+
+    static void begin_frame() { s_frame_stats = FrameStats(); }
+    static FrameStats const get_frame_stats() { return s_frame_stats; }
+};
@@ -0,0 +1,145 @@
+#ifdef HEADLESS_EGL
+#include "HeadlessContext.h"
+#include <EGL/eglext.h>
+#include <cstdio>
+#include <iostream>
+
+HeadlessContext::HeadlessContext(int width, int height)
+    : m_width(width), m_height(height)
+{
+}
+
+HeadlessContext::~HeadlessContext()
+{
+    if (m_display == EGL_NO_DISPLAY) return;
+
+    if (m_framebuffer != 0)
+    {
+        glDeleteFramebuffers(1, &m_framebuffer);
+        glDeleteRenderbuffers(1, &m_colour_buffer);
+    }
+
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_context != EGL_NO_CONTEXT) eglDestroyContext(m_display, m_context);
+    eglTerminate(m_display);
+}
+
+// Prefers Mesa's surfaceless platform, which needs neither X nor a DRM device;
+// falls back to whatever the default display is
+EGLDisplay HeadlessContext::open_display()
+{
+    PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+    if (get_platform_display != nullptr)
+    {
+        EGLDisplay display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) return display;
+    }
+
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) return display;
+
+    return EGL_NO_DISPLAY;
+}
+
+bool HeadlessContext::create()
+{
+    m_display = open_display();
+    if (m_display == EGL_NO_DISPLAY)
+    {
+        std::cerr << "Error: no EGL display available for headless rendering.\n";
+        return false;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        std::cerr << "Error: EGL can't create desktop OpenGL contexts.\n";
+        return false;
+    }
+
+    // Same context the window would get: 3.3 core, or whatever 2.1 maps to
+    // for the legacy renderer
+#ifdef USE_LEGACY_GL
+    const EGLint context_attributes[] = { EGL_NONE };
+#else
+    const EGLint context_attributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION,       3,
+        EGL_CONTEXT_MINOR_VERSION,       3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+#endif
+
+    // Surfaceless contexts don't need a config, but some drivers insist on one
+    const EGLint config_attributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config  = nullptr;
+    EGLint    configs = 0;
+    eglChooseConfig(m_display, config_attributes, &config, 1, &configs);
+
+    m_context = eglCreateContext(m_display, configs > 0 ? config : (EGLConfig) nullptr,
+                                 EGL_NO_CONTEXT, context_attributes);
+    if (m_context == EGL_NO_CONTEXT ||
+        !eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_context))
+    {
+        std::cerr << "Error: could not create a surfaceless GL context (EGL error 0x"
+                  << std::hex << eglGetError() << std::dec << ").\n";
+        return false;
+    }
+
+    // ————— FRAMEBUFFER ————— //
+    glGenRenderbuffers(1, &m_colour_buffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colour_buffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_width, m_height);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colour_buffer);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "Error: headless framebuffer is incomplete.\n";
+        return false;
+    }
+
+    m_pixels.resize((size_t) m_width * m_height * 4);
+    m_row.resize((size_t) m_width * 3);
+    return true;
+}
+
+void HeadlessContext::finish()
+{
+    glFinish();
+}
+
+bool HeadlessContext::capture(const char *filepath)
+{
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, m_pixels.data());
+
+    FILE *file = fopen(filepath, "wb");
+    if (file == nullptr)
+    {
+        std::cerr << "Error: could not write " << filepath << ".\n";
+        return false;
+    }
+
+    fprintf(file, "P6\n%d %d\n255\n", m_width, m_height);
+
+    // GL rows run bottom-up, image rows top-down
+    for (int y = m_height - 1; y >= 0; y--)
+    {
+        const unsigned char *source = &m_pixels[(size_t) y * m_width * 4];
+        for (int x = 0; x < m_width; x++)
+        {
+            m_row[x * 3 + 0] = source[x * 4 + 0];
+            m_row[x * 3 + 1] = source[x * 4 + 1];
+            m_row[x * 3 + 2] = source[x * 4 + 2];
+        }
+        fwrite(m_row.data(), 1, m_row.size(), file);
+    }
+
+    fclose(file);
+    return true;
+}
+#endif
@@ -0,0 +1,52 @@
+#pragma once
+#ifdef HEADLESS_EGL
+#define GL_SILENCE_DEPRECATION
+#define GL_GLEXT_PROTOTYPES 1
+#include <EGL/egl.h>
+#include <SDL_opengl.h>
+#include <vector>
+
+// An offscreen GL context for machines with no display or GPU. It asks EGL
+// for a surfaceless display (Mesa's llvmpipe is fine) and renders into a
+// framebuffer object the size of the window it stands in for, so everything
+// that would normally draw to the window draws here instead.
+//
+// Only built with -DHEADLESS_EGL (Linux, link with -lEGL -lGL).
+class HeadlessContext
+{
+private:
+    int m_width, m_height;
+
+    EGLDisplay m_display = EGL_NO_DISPLAY;
+    EGLContext m_context = EGL_NO_CONTEXT;
+
+    GLuint m_framebuffer   = 0;
+    GLuint m_colour_buffer = 0;
+
+    // Readback scratch, sized once so captures don't allocate
+    std::vector<unsigned char> m_pixels;
+    std::vector<unsigned char> m_row;
+
+    EGLDisplay open_display();
+
+public:
+    HeadlessContext(int width, int height);
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    // Creates the context and its framebuffer and makes them current.
+    // Returns false (after logging why) if the platform can't provide one.
+    bool create();
+
+    // Blocks until the GPU has finished the frame, so frame times include it
+    void finish();
+
+    // Reads the framebuffer back and writes it as a binary PPM
+    bool capture(const char *filepath);
+
+    int const get_width()  const { return m_width;  }
+    int const get_height() const { return m_height; }
+};
+#endif
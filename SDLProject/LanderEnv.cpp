@@ -0,0 +1,337 @@
+#define GL_SILENCE_DEPRECATION
+#define GL_GLEXT_PROTOTYPES 1
+
+#include "LanderEnv.h"
+#include "Map.h"
+#include "Systems.h"
+#include <math.h>
+#include <algorithm>
+
+constexpr float LanderEnv::MAX_CLEARANCE;
+
+constexpr float PHYSICS_STEP   = 0.0166666f;  // FIXED_TIMESTEP in main.cpp
+constexpr float FALL_THRESHOLD = -5.5f;       // likewise
+
+// splitmix64, one generator per environment: tiny, and good enough for spawns
+static float next_random(uint64_t &state)
+{
+    uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z ^= z >> 31;
+    return (float) (z >> 40) * (1.0f / 16777216.0f);  // [0, 1)
+}
+
+static float random_between(uint64_t &state, float low, float high)
+{
+    return low + (high - low) * next_random(state);
+}
+
+LanderEnv::LanderEnv(Map *map, int count) : LanderEnv(map, count, Settings()) { }
+
+LanderEnv::LanderEnv(Map *map, int count, const Settings &settings)
+    : m_map(map), m_settings(settings), m_count(std::max(0, count))
+{
+    if (m_settings.spawn_max_x <= 0.0f) m_settings.spawn_max_x = (map->get_width() - 1) * map->get_tile_size();
+    m_settings.physics_steps_per_action = std::max(1, m_settings.physics_steps_per_action);
+
+    // Every lander gets the same components in the same order, so they line
+    // up across the pools
+    m_world.reserve(m_count);
+    for (int i = 0; i < m_count; i++)
+    {
+        EntityId lander = m_world.create();
+        m_world.add<Transform>(lander);
+        m_world.add<Velocity>(lander);
+        m_world.add<Collider>(lander);
+        m_world.add<Fuel>(lander);
+        m_world.add<AI>(lander);
+        m_landers.push_back(lander);
+    }
+
+    // Where the pads are doesn't depend on the lander's size
+    m_pads = Autopilot(map, 1.0f, 1.0f).get_pads();
+
+    m_random.assign(m_count, 0);
+    m_potentials.assign(m_count, 0.0f);
+    m_actions_taken.assign(m_count, 0);
+    m_outcomes.assign(m_count, RUNNING);
+    m_fuel_before.assign(m_count, 0.0f);
+
+    m_observations.assign((size_t) m_count * OBSERVATION_SIZE, 0.0f);
+    m_rewards.assign(m_count, 0.0f);
+    m_dones.assign(m_count, 0);
+
+    // No point in more threads than environments
+    int threads = m_settings.threads > 0 ? m_settings.threads : (int) std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max(1, std::min(threads, m_count));
+    for (int worker = 1; worker < threads; worker++)
+    {
+        m_workers.push_back(std::thread(&LanderEnv::worker_loop, this, worker));
+    }
+}
+
+LanderEnv::~LanderEnv()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_start.notify_all();
+    for (std::thread &worker : m_workers) worker.join();
+}
+
+// ————— WORKERS ————— //
+void LanderEnv::worker_loop(int worker)
+{
+    unsigned seen = 0;
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [this, seen] { return m_stopping || m_generation != seen; });
+            if (m_stopping) return;
+
+            seen = m_generation;
+            job  = m_job;
+        }
+
+        run_share(job, worker, (int) m_workers.size() + 1);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pending == 0) m_finished.notify_one();
+    }
+}
+
+void LanderEnv::run(Job job)
+{
+    if (m_workers.empty())
+    {
+        run_share(job, 0, 1);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job     = job;
+        m_pending = (int) m_workers.size();
+        m_generation++;
+    }
+    m_start.notify_all();
+
+    run_share(job, 0, (int) m_workers.size() + 1);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished.wait(lock, [this] { return m_pending == 0; });
+}
+
+// Contiguous shares, so each thread writes its own stretch of the buffers
+void LanderEnv::run_share(Job job, int share, int shares)
+{
+    int first = (int) ((int64_t) m_count * share / shares);
+    int last  = (int) ((int64_t) m_count * (share + 1) / shares);
+
+    if (job == STEP)
+    {
+        step_share(first, last);
+        return;
+    }
+
+    for (int index = first; index < last; index++) reset_one(index, m_seeds[index]);
+}
+
+// ————— BATCHES ————— //
+LanderEnv::Batch LanderEnv::reset(const uint32_t *seeds)
+{
+    m_seeds = seeds;
+    run(RESET);
+    return get_batch();
+}
+
+void LanderEnv::reset(int index, uint32_t seed)
+{
+    reset_one(index, seed);
+}
+
+LanderEnv::Batch LanderEnv::step(const LanderInput *inputs)
+{
+    m_inputs = inputs;
+    run(STEP);
+    return get_batch();
+}
+
+LanderEnv::Batch LanderEnv::get_batch() const
+{
+    Batch batch;
+    batch.observations = m_observations.data();
+    batch.rewards      = m_rewards.data();
+    batch.dones        = m_dones.data();
+    batch.count        = m_count;
+    return batch;
+}
+
+// ————— ONE ENVIRONMENT ————— //
+void LanderEnv::reset_one(int index, uint32_t seed)
+{
+    uint64_t &random = m_random[index];
+    random = seed;
+
+    LanderState state;
+    state.x          = random_between(random, m_settings.spawn_min_x, m_settings.spawn_max_x);
+    state.y          = random_between(random, m_settings.spawn_min_y, m_settings.spawn_max_y);
+    state.velocity_x = random_between(random, -m_settings.spawn_speed, m_settings.spawn_speed);
+    state.velocity_y = random_between(random, -m_settings.spawn_speed, m_settings.spawn_speed);
+    state.angle      = random_between(random, -m_settings.spawn_angle, m_settings.spawn_angle);
+    state.fuel       = m_settings.fuel;
+
+    EntityId lander = m_landers[index];
+    Systems::set_lander_state(m_world, lander, state);
+    *m_world.get<Collider>(lander) = Collider();
+    m_world.get<Fuel>(lander)->burning = false;
+    m_world.get<AI>(lander)->input     = LanderInput();
+
+    m_actions_taken[index] = 0;
+    m_outcomes[index]      = RUNNING;
+    m_rewards[index]       = 0.0f;
+    m_dones[index]         = 0;
+    m_potentials[index]    = potential(index);
+    observe(index);
+}
+
+// One action for every environment in [first, last), stepped the way
+// simulate_step steps the player: the systems run over the whole stretch a
+// physics step at a time, and leave alone whatever's already finished.
+// Lander i sits at position i in every pool.
+void LanderEnv::step_share(int first, int last)
+{
+    Transform *transforms = m_world.pool<Transform>().data();
+    Collider  *colliders  = m_world.pool<Collider>().data();
+    Fuel      *fuel       = m_world.pool<Fuel>().data();
+    AI        *pilots     = m_world.pool<AI>().data();
+
+    for (int index = first; index < last; index++)
+    {
+        const LanderInput &input = m_inputs[index];
+        pilots[index].input.torque = std::max(-1.0f, std::min(1.0f, input.torque));
+        pilots[index].input.thrust = input.thrust;
+        m_fuel_before[index] = fuel[index].amount;
+    }
+
+    for (int step = 0; step < m_settings.physics_steps_per_action; step++)
+    {
+        Systems::move(m_world, PHYSICS_STEP, first, last);
+        Systems::collide(m_world, m_map, first, last);
+
+        bool running = false;
+        for (int index = first; index < last; index++)
+        {
+            if (m_outcomes[index] != RUNNING) continue;
+
+            const Transform &transform = transforms[index];
+            if (colliders[index].finished)
+            {
+                m_outcomes[index] = colliders[index].touched_tile == (int) Map::LANDING_PAD_TILE ? LANDED : CRASHED;
+            }
+            else if (transform.y < FALL_THRESHOLD)
+            {
+                m_outcomes[index] = CRASHED;
+            }
+            else if (transform.x < m_map->get_left_bound() - m_settings.margin ||
+                     transform.x > m_map->get_right_bound() + m_settings.margin ||
+                     transform.y > m_settings.spawn_max_y + m_settings.margin)
+            {
+                m_outcomes[index] = LOST;
+            }
+
+            // Stops the systems moving it for the rest of the action
+            colliders[index].finished = m_outcomes[index] != RUNNING;
+            running |= m_outcomes[index] == RUNNING;
+        }
+        if (!running) break;
+    }
+
+    for (int index = first; index < last; index++)
+    {
+        // Already done before this action
+        if (m_dones[index])
+        {
+            m_rewards[index] = 0.0f;
+            continue;
+        }
+
+        if (m_outcomes[index] == RUNNING && ++m_actions_taken[index] >= m_settings.max_actions)
+        {
+            m_outcomes[index] = TIMED_OUT;
+            colliders[index].finished = true;
+        }
+
+        // Shaping is the change in potential, so it can't be farmed by hovering
+        float now    = potential(index);
+        float reward = now - m_potentials[index] - m_settings.fuel_weight * (m_fuel_before[index] - fuel[index].amount);
+        m_potentials[index] = now;
+
+        if (m_outcomes[index] == LANDED) reward += m_settings.landed_reward;
+        if (m_outcomes[index] == CRASHED || m_outcomes[index] == LOST) reward += m_settings.crashed_reward;
+
+        m_rewards[index] = reward;
+        m_dones[index]   = m_outcomes[index] != RUNNING;
+        observe(index);
+    }
+}
+
+const Autopilot::Pad* LanderEnv::nearest_pad(float x) const
+{
+    const Autopilot::Pad *nearest = nullptr;
+    for (const Autopilot::Pad &pad : m_pads)
+    {
+        if (nearest == nullptr || fabsf(pad.x - x) < fabsf(nearest->x - x)) nearest = &pad;
+    }
+    return nearest;
+}
+
+// Higher the closer the lander is to sitting still and upright on a pad
+float LanderEnv::potential(int index) const
+{
+    LanderState state = get_lander_state(index);
+
+    float distance = 0.0f;
+    if (const Autopilot::Pad *pad = nearest_pad(state.x))
+    {
+        float offset_x = state.x - pad->x;
+        float offset_y = state.y - m_world.pool<Collider>().data()[index].height / 2 - pad->y;
+        distance = sqrtf(offset_x * offset_x + offset_y * offset_y);
+    }
+    float speed = sqrtf(state.velocity_x * state.velocity_x + state.velocity_y * state.velocity_y);
+
+    return -m_settings.distance_weight * distance - m_settings.speed_weight * speed -
+           m_settings.angle_weight * fabsf(state.angle);
+}
+
+void LanderEnv::observe(int index)
+{
+    LanderState state = get_lander_state(index);
+    float feet = state.y - m_world.pool<Collider>().data()[index].height / 2;
+
+    float *row = &m_observations[(size_t) index * OBSERVATION_SIZE];
+    row[POSITION_X]       = state.x;
+    row[POSITION_Y]       = state.y;
+    row[VELOCITY_X]       = state.velocity_x;
+    row[VELOCITY_Y]       = state.velocity_y;
+    row[SIN_ANGLE]        = sinf(state.angle);
+    row[COS_ANGLE]        = cosf(state.angle);
+    row[ANGULAR_VELOCITY] = state.angular_velocity;
+    row[FUEL]             = m_settings.fuel > 0.0f ? std::max(0.0f, state.fuel) / m_settings.fuel : 0.0f;
+
+    const Autopilot::Pad *pad = nearest_pad(state.x);
+    row[PAD_OFFSET_X] = pad != nullptr ? state.x - pad->x : 0.0f;
+    row[PAD_OFFSET_Y] = pad != nullptr ? feet - pad->y    : 0.0f;
+
+    Map::RaycastHit below = m_map->raycast(glm::vec3(state.x, feet, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), MAX_CLEARANCE);
+    row[CLEARANCE] = below.hit ? below.distance : MAX_CLEARANCE;
+}
+
+LanderState LanderEnv::get_lander_state(int index) const
+{
+    return Systems::lander_state(m_world, m_landers[index]);
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "LanderPhysics.h"
+#include "Autopilot.h"
+#include "World.h"
+
+class Map;
+
+// N copies of the game stepped together for training controllers: no
+// window, no rendering, just a World of landers flown by the same systems
+// against the real Map exactly as the simulation thread does, split across
+// worker threads. Environment i is the i'th entity in every pool, so each
+// thread's share is a contiguous stretch of each component array.
+//
+// reset() and step() hand back views of buffers the environment owns, so
+// nothing is copied out. They stay valid, and get overwritten in place,
+// until the next call. Row i of the observations is environment i's.
+//
+// Environments that finish stay finished (reward 0, done) until they're
+// reset, alone or all together. Everything is allocated up front, so stepping
+// never touches the heap, and each environment only depends on its own seed
+// and actions, so results don't change with the thread count.
+class LanderEnv
+{
+public:
+    // What each row of the observation buffer holds
+    enum Observation
+    {
+        POSITION_X, POSITION_Y,
+        VELOCITY_X, VELOCITY_Y,
+        SIN_ANGLE, COS_ANGLE, ANGULAR_VELOCITY,
+        FUEL,                        // fraction of the starting tank
+        PAD_OFFSET_X, PAD_OFFSET_Y,  // from the nearest pad's middle to the feet
+        CLEARANCE,                   // open space straight below the feet, up to MAX_CLEARANCE
+        OBSERVATION_SIZE
+    };
+
+    enum Outcome : uint8_t { RUNNING, LANDED, CRASHED, LOST, TIMED_OUT };
+
+    static constexpr float MAX_CLEARANCE = 8.0f;
+
+    struct Settings
+    {
+        int threads = 0;  // 0: one per core
+
+        // Spawns are drawn from these ranges by each environment's seed. A
+        // spawn_max_x of 0 means a tile in from the map's right edge.
+        float spawn_min_x = 1.0f, spawn_max_x = 0.0f;
+        float spawn_min_y = 1.5f, spawn_max_y = 3.0f;
+        float spawn_speed = 0.5f;   // up to this on each axis, either way
+        float spawn_angle = 0.3f;   // radians, either way
+        float fuel        = 500.0f;
+
+        int   physics_steps_per_action = 1;
+        int   max_actions = 3600;  // a minute of game time, at one step per action
+        float margin      = 2.0f;  // how far off the map's sides or top before it's lost
+
+        // Terminal rewards, and shaping that adds up to how much closer the
+        // lander got to a slow, upright arrival at the nearest pad
+        float landed_reward   = 100.0f;
+        float crashed_reward  = -100.0f;
+        float distance_weight = 1.0f;
+        float speed_weight    = 1.0f;
+        float angle_weight    = 0.5f;
+        float fuel_weight     = 0.01f;  // per unit of fuel burned
+    };
+
+    // Views of the environment's own buffers
+    struct Batch
+    {
+        const float   *observations;  // count * OBSERVATION_SIZE
+        const float   *rewards;       // count
+        const uint8_t *dones;         // count, 1 once an environment has finished
+        int count;
+    };
+
+private:
+    Map *m_map;
+    Settings m_settings;
+    int m_count;
+
+    std::vector<Autopilot::Pad> m_pads;
+    World                  m_world;
+    std::vector<EntityId>  m_landers;
+    std::vector<uint64_t>  m_random;     // per environment generator state
+    std::vector<float>     m_potentials;
+    std::vector<int>       m_actions_taken;
+    std::vector<Outcome>   m_outcomes;
+    std::vector<float>     m_fuel_before;  // at the start of the current action
+
+    std::vector<float>   m_observations;
+    std::vector<float>   m_rewards;
+    std::vector<uint8_t> m_dones;
+
+    // ————— WORKERS ————— //
+    // The calling thread takes the first share of each batch; the workers
+    // sleep between batches
+    enum Job { RESET, STEP };
+
+    std::vector<std::thread> m_workers;
+    std::mutex               m_mutex;
+    std::condition_variable  m_start, m_finished;
+    unsigned m_generation = 0;
+    int      m_pending    = 0;
+    bool     m_stopping   = false;
+
+    Job                m_job;
+    const uint32_t    *m_seeds   = nullptr;
+    const LanderInput *m_inputs  = nullptr;
+
+    void worker_loop(int worker);
+    void run(Job job);
+    void run_share(Job job, int share, int shares);
+
+    // ————— ONE ENVIRONMENT ————— //
+    void  reset_one(int index, uint32_t seed);
+    void  step_share(int first, int last);
+    void  observe(int index);
+    float potential(int index) const;
+    const Autopilot::Pad* nearest_pad(float x) const;
+
+public:
+    LanderEnv(Map *map, int count);
+    LanderEnv(Map *map, int count, const Settings &settings);
+    ~LanderEnv();
+
+    LanderEnv(const LanderEnv&) = delete;
+    LanderEnv& operator=(const LanderEnv&) = delete;
+
+    // Starts every environment afresh, environment i from seeds[i]
+    Batch reset(const uint32_t *seeds);
+    // Starts just one afresh; the others carry on
+    void  reset(int index, uint32_t seed);
+
+    // Flies inputs[i] in environment i for physics_steps_per_action steps
+    Batch step(const LanderInput *inputs);
+
+    Batch   get_batch() const;
+    Outcome get_outcome(int index) const { return m_outcomes[index]; }
+    LanderState get_lander_state(int index) const;
+    const World& get_world() const { return m_world; }
+    int  get_count() const { return m_count; }
+    int  get_thread_count() const { return (int) m_workers.size() + 1; }
+    const Settings& get_settings() const { return m_settings; }
+};
@@ -0,0 +1,63 @@
+#include "LanderPhysics.h"
+#include "FastTrig.h"
+#include <algorithm>
+
+namespace LanderPhysics
+{
+    // Gains for levelling_torque: critically damped at about 3 rad/s given
+    // the acceleration and damping above
+    constexpr float LEVEL_GAIN    = 1.5f;
+    constexpr float LEVEL_DAMPING = 0.75f;
+
+    constexpr float PI     = 3.14159265f;
+    constexpr float TWO_PI = 6.28318531f;
+
+    float wrap_angle(float radians)
+    {
+        if (radians >= -PI && radians < PI) return radians;
+        return radians - TWO_PI * floorf((radians + PI) / TWO_PI);
+    }
+
+    float levelling_torque(const LanderState &state)
+    {
+        float torque = -(LEVEL_GAIN * state.angle + LEVEL_DAMPING * state.angular_velocity);
+        return std::max(-1.0f, std::min(1.0f, torque));
+    }
+
+    void integrate(LanderState &state, const LanderInput &input, float delta_time)
+    {
+        // ————— ROTATION ————— //
+        float torque = std::max(-1.0f, std::min(1.0f, input.torque));
+        float angular_acceleration = torque * ANGULAR_ACCELERATION
+                                   - ANGULAR_DAMPING * state.angular_velocity;
+
+        state.angular_velocity += angular_acceleration * delta_time;
+        state.angular_velocity  = std::max(-MAX_ANGULAR_VELOCITY,
+                                           std::min(MAX_ANGULAR_VELOCITY, state.angular_velocity));
+        state.angle = wrap_angle(state.angle + state.angular_velocity * delta_time);
+
+        // ————— THRUST ————— //
+        float acceleration_x = 0.0f,
+              acceleration_y = GRAVITY;
+
+        if (input.thrust && state.fuel > 0.0f)
+        {
+            float sine, cosine;
+            fast_sincos(state.angle, &sine, &cosine);
+
+            acceleration_x += sine   * THRUST_ACCELERATION;
+            acceleration_y += cosine * THRUST_ACCELERATION;
+            state.fuel = std::max(0.0f, state.fuel - FUEL_BURN_RATE * delta_time);
+        }
+
+        state.velocity_x += acceleration_x * delta_time;
+        state.velocity_y += acceleration_y * delta_time;
+
+        // Drift bleeds sideways speed off in proportion to it, so even a
+        // slight tilt still builds up some sideways motion
+        state.velocity_x -= state.velocity_x * DRIFT * delta_time;
+
+        state.x += state.velocity_x * delta_time;
+        state.y += state.velocity_y * delta_time;
+    }
+}
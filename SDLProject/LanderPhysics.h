@@ -0,0 +1,45 @@
+#pragma once
+
+// Rigid-body flight model for the lander, kept apart from the World so the
+// same step can run on plain structs (many landers at once, autopilot
+// rollouts) without any textures, animation or map attached.
+//
+// The heading is clockwise from straight up, matching the sprite's rotation,
+// so thrust pushes along (sin angle, cos angle).
+
+struct LanderState
+{
+    float x = 0.0f, y = 0.0f;
+    float velocity_x = 0.0f, velocity_y = 0.0f;
+    float angle = 0.0f;             // radians, clockwise from up
+    float angular_velocity = 0.0f;  // radians per second, clockwise
+    float fuel = 0.0f;
+};
+
+struct LanderInput
+{
+    float torque = 0.0f;  // -1 (full left) to 1 (full right)
+    bool  thrust = false;
+};
+
+namespace LanderPhysics
+{
+    constexpr float GRAVITY              = -0.5f;   // units/s^2
+    constexpr float THRUST_ACCELERATION  =  1.25f;  // units/s^2 along the heading
+    constexpr float DRIFT                =  0.3f;   // horizontal drag, per second
+    constexpr float ANGULAR_ACCELERATION =  6.0f;   // rad/s^2 at full torque
+    constexpr float ANGULAR_DAMPING      =  1.5f;   // per second
+    constexpr float MAX_ANGULAR_VELOCITY =  4.0f;   // rad/s
+    constexpr float FUEL_BURN_RATE       = 60.0f;   // fuel per second of thrust
+
+    // Advances one lander by delta_time (semi-implicit Euler). Thrust only
+    // fires while there's fuel left; collisions are the caller's business.
+    void integrate(LanderState &state, const LanderInput &input, float delta_time);
+
+    // Torque that swings the lander back upright and stops it there without
+    // overshooting (what W does)
+    float levelling_torque(const LanderState &state);
+
+    // Wraps an angle into [-pi, pi)
+    float wrap_angle(float radians);
+}
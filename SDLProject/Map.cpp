@@ -8,6 +8,21 @@
 * Academic Misconduct.
 **/
 #include "Map.h"
+#include "GLState.h"
+#include "Mesh.h"
+#include <string.h>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MAP_SSE2
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define MAP_NEON
+#endif
 
 #define TILE_COUNT_X 4  // 4 tiles horizontally
 #define TILE_COUNT_Y 1  // 1 tile vertically
@@ -16,10 +31,17 @@
 Map::Map(int width, int height, unsigned int *level_data, GLuint texture_id, float tile_size, int tile_count_x, int tile_count_y)
     : m_width(width), m_height(height),
       m_level_data(level_data), m_texture_id(texture_id),
-      m_tile_size(tile_size), m_tile_count_x(tile_count_x),
+      m_tile_size(tile_size), m_inverse_tile_size(1.0f / tile_size),
+      m_tile_count_x(tile_count_x),
       m_tile_count_y(tile_count_y)
 {
     build();
+    m_occupancy.build(m_level_data, m_width, m_height);
+}
+
+Map::~Map()
+{
+    delete m_mesh;
 }
 
 // Build function to initialize vertices and texture coordinates for each tile
@@ -27,6 +49,10 @@ void Map::build()
 {
     float padding = 0.0f;  // Set padding to zero to remove gaps within tiles
 
+    m_vertices.clear();
+    m_texture_coordinates.clear();
+    m_mesh_dirty = true;
+
     for (int y_coord = 0; y_coord < m_height; y_coord++)
     {
         for (int x_coord = 0; x_coord < m_width; x_coord++)
@@ -80,23 +106,33 @@ void Map::build()
 // Render function
 void Map::render(ShaderProgram *program)
 {
-    glm::mat4 model_matrix = glm::mat4(1.0f);
-    program->set_model_matrix(model_matrix);
-    
-    glUseProgram(program->get_program_id());
-    
-    glVertexAttribPointer(program->get_position_attribute(), 2, GL_FLOAT, false, 0, m_vertices.data());
-    glEnableVertexAttribArray(program->get_position_attribute());
-    glVertexAttribPointer(program->get_tex_coordinate_attribute(), 2, GL_FLOAT, false, 0, m_texture_coordinates.data());
-    glEnableVertexAttribArray(program->get_tex_coordinate_attribute());
+    if (m_mesh_dirty)
+    {
+        // Interleave positions and UVs into the mesh's (x, y, u, v) layout
+        int vertex_count = (int) m_vertices.size() / 2;
+        std::vector<float> interleaved(vertex_count * Mesh::FLOATS_PER_VERTEX);
+
+        for (int i = 0; i < vertex_count; i++)
+        {
+            interleaved[i * 4 + 0] = m_vertices[i * 2 + 0];
+            interleaved[i * 4 + 1] = m_vertices[i * 2 + 1];
+            interleaved[i * 4 + 2] = m_texture_coordinates[i * 2 + 0];
+            interleaved[i * 4 + 3] = m_texture_coordinates[i * 2 + 1];
+        }
+
+        if (m_mesh == nullptr) m_mesh = new Mesh(GL_STATIC_DRAW);
+        m_mesh->upload(interleaved.data(), vertex_count);
+        m_mesh_dirty = false;
+    }
+
+    // Tiles are built in world space
+    program->set_model_transform(Transform2D());
+    program->reset_texture_rect();
     
-    glBindTexture(GL_TEXTURE_2D, m_texture_id);
+    GLState::bind_texture(m_texture_id);
     
     // Draw all the vertices
-    glDrawArrays(GL_TRIANGLES, 0, (int) m_vertices.size() / 2);
-    
-    glDisableVertexAttribArray(program->get_position_attribute());
-    glDisableVertexAttribArray(program->get_tex_coordinate_attribute());
+    m_mesh->draw();
 }
 
 // Check if a tile is solid for collision detection
@@ -105,9 +141,9 @@ bool Map::is_solid(glm::vec3 position, float *penetration_x, float *penetration_
     *penetration_x = 0;
     *penetration_y = 0;
 
-    // Calculate tile indices for the position
-    int tile_x = static_cast<int>(floor(position.x / m_tile_size));
-    int tile_y = static_cast<int>(-ceil(position.y / m_tile_size));
+    // Calculate tile indices for the position (-ceil(y) is floor(-y))
+    int tile_x = static_cast<int>(floor(position.x * m_inverse_tile_size));
+    int tile_y = static_cast<int>(floor(-position.y * m_inverse_tile_size));
 
     // Check bounds of the map
     if (tile_x < 0 || tile_x >= m_width || tile_y < 0 || tile_y >= m_height) return false;
@@ -127,9 +163,402 @@ bool Map::is_solid(glm::vec3 position, float *penetration_x, float *penetration_
     return true;
 }
 
+// ————— BATCH PROBES ————— //
+// Each block of four: tile coordinates by multiply and floor, one bounds mask,
+// a gather of the four tile values (hardware gather with AVX2, four loads
+// otherwise), then penetrations masked down to the solid lanes. Whatever's
+// left over after the last full block goes through the scalar version.
+static const int BITS_SET[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+int Map::is_solid_batch(const float *xs, const float *ys, int count, const ProbeResults &results) const
+{
+    int   *tile_types    = results.tile_types;
+    float *penetration_x = results.penetration_x;
+    float *penetration_y = results.penetration_y;
+
+    const float half_tile = m_tile_size * 0.5f;
+    const unsigned int *level = m_level_data;
+
+    if (results.solid_bits) memset(results.solid_bits, 0, ((count + 31) / 32) * sizeof(unsigned int));
+
+    int solid_count = 0;
+    int i = 0;
+
+#if defined(MAP_SSE2)
+    const __m128  inverse4   = _mm_set1_ps(m_inverse_tile_size);
+    const __m128  tile4      = _mm_set1_ps(m_tile_size);
+    const __m128  half4      = _mm_set1_ps(half_tile);
+    const __m128  sign_bit   = _mm_set1_ps(-0.0f);
+    const __m128i width4     = _mm_set1_epi32(m_width);
+    const __m128i height4    = _mm_set1_epi32(m_height);
+    const __m128i minus_one  = _mm_set1_epi32(-1);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+
+        // floor(v) = truncate(v), minus one where truncating rounded up
+        __m128  scaled_x = _mm_mul_ps(x, inverse4);
+        __m128  scaled_y = _mm_xor_ps(_mm_mul_ps(y, inverse4), sign_bit);
+        __m128i tile_x   = _mm_cvttps_epi32(scaled_x);
+        __m128i tile_y   = _mm_cvttps_epi32(scaled_y);
+        tile_x = _mm_add_epi32(tile_x, _mm_castps_si128(_mm_cmplt_ps(scaled_x, _mm_cvtepi32_ps(tile_x))));
+        tile_y = _mm_add_epi32(tile_y, _mm_castps_si128(_mm_cmplt_ps(scaled_y, _mm_cvtepi32_ps(tile_y))));
+
+        __m128i inside = _mm_and_si128(
+            _mm_and_si128(_mm_cmpgt_epi32(tile_x, minus_one), _mm_cmplt_epi32(tile_x, width4)),
+            _mm_and_si128(_mm_cmpgt_epi32(tile_y, minus_one), _mm_cmplt_epi32(tile_y, height4)));
+
+#if defined(__AVX2__)
+        __m128i index = _mm_and_si128(_mm_add_epi32(_mm_mullo_epi32(tile_y, width4), tile_x), inside);
+        __m128i tiles = _mm_mask_i32gather_epi32(_mm_setzero_si128(), (const int *) level, index, inside, 4);
+#else
+        alignas(16) int tx[4], ty[4], in[4];
+        _mm_store_si128((__m128i *) tx, tile_x);
+        _mm_store_si128((__m128i *) ty, tile_y);
+        _mm_store_si128((__m128i *) in, inside);
+        __m128i tiles = _mm_setr_epi32(in[0] ? (int) level[ty[0] * m_width + tx[0]] : 0,
+                                       in[1] ? (int) level[ty[1] * m_width + tx[1]] : 0,
+                                       in[2] ? (int) level[ty[2] * m_width + tx[2]] : 0,
+                                       in[3] ? (int) level[ty[3] * m_width + tx[3]] : 0);
+#endif
+        // -1 outside the map, the tile value inside
+        tiles = _mm_or_si128(_mm_and_si128(inside, tiles), _mm_andnot_si128(inside, minus_one));
+        __m128 solid = _mm_castsi128_ps(_mm_cmpgt_epi32(tiles, _mm_setzero_si128()));
+
+        // Tile centres are (tile + 0.5) * size across and -(tile + 0.5) * size down
+        __m128 centre_x = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(tile_x), tile4), half4);
+        __m128 centre_y = _mm_xor_ps(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(tile_y), tile4), half4), sign_bit);
+        __m128 depth_x  = _mm_sub_ps(half4, _mm_andnot_ps(sign_bit, _mm_sub_ps(x, centre_x)));
+        __m128 depth_y  = _mm_sub_ps(half4, _mm_andnot_ps(sign_bit, _mm_sub_ps(y, centre_y)));
+
+        _mm_storeu_si128((__m128i *) (tile_types + i), tiles);
+        _mm_storeu_ps(penetration_x + i, _mm_and_ps(solid, depth_x));
+        _mm_storeu_ps(penetration_y + i, _mm_and_ps(solid, depth_y));
+
+        unsigned int hits = (unsigned int) _mm_movemask_ps(solid);
+        if (results.solid_bits) results.solid_bits[i / 32] |= hits << (i % 32);
+        solid_count += BITS_SET[hits];
+    }
+#elif defined(MAP_NEON)
+    const float32x4_t inverse4  = vdupq_n_f32(m_inverse_tile_size);
+    const float32x4_t tile4     = vdupq_n_f32(m_tile_size);
+    const float32x4_t half4     = vdupq_n_f32(half_tile);
+    const int32x4_t   width4    = vdupq_n_s32(m_width);
+    const int32x4_t   height4   = vdupq_n_s32(m_height);
+    const int32x4_t   zero4     = vdupq_n_s32(0);
+    const uint32x4_t  lane_bits = { 1, 2, 4, 8 };
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t x = vld1q_f32(xs + i);
+        float32x4_t y = vld1q_f32(ys + i);
+
+        int32x4_t tile_x = vcvtmq_s32_f32(vmulq_f32(x, inverse4));
+        int32x4_t tile_y = vcvtmq_s32_f32(vnegq_f32(vmulq_f32(y, inverse4)));
+
+        uint32x4_t inside = vandq_u32(
+            vandq_u32(vcgeq_s32(tile_x, zero4), vcltq_s32(tile_x, width4)),
+            vandq_u32(vcgeq_s32(tile_y, zero4), vcltq_s32(tile_y, height4)));
+
+        int32x4_t index = vandq_s32(vmlaq_s32(tile_x, tile_y, width4), vreinterpretq_s32_u32(inside));
+        int32x4_t tiles = { (int) level[vgetq_lane_s32(index, 0)], (int) level[vgetq_lane_s32(index, 1)],
+                            (int) level[vgetq_lane_s32(index, 2)], (int) level[vgetq_lane_s32(index, 3)] };
+        tiles = vbslq_s32(inside, tiles, vdupq_n_s32(-1));
+        uint32x4_t solid = vcgtq_s32(tiles, zero4);
+
+        float32x4_t centre_x = vmlaq_f32(half4, vcvtq_f32_s32(tile_x), tile4);
+        float32x4_t centre_y = vnegq_f32(vmlaq_f32(half4, vcvtq_f32_s32(tile_y), tile4));
+        float32x4_t depth_x  = vsubq_f32(half4, vabdq_f32(x, centre_x));
+        float32x4_t depth_y  = vsubq_f32(half4, vabdq_f32(y, centre_y));
+
+        vst1q_s32(tile_types + i, tiles);
+        vst1q_f32(penetration_x + i, vreinterpretq_f32_u32(vandq_u32(solid, vreinterpretq_u32_f32(depth_x))));
+        vst1q_f32(penetration_y + i, vreinterpretq_f32_u32(vandq_u32(solid, vreinterpretq_u32_f32(depth_y))));
+
+        unsigned int hits = vaddvq_u32(vandq_u32(solid, lane_bits));
+        if (results.solid_bits) results.solid_bits[i / 32] |= hits << (i % 32);
+        solid_count += BITS_SET[hits];
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        int tile_x = static_cast<int>(floorf(xs[i] * m_inverse_tile_size));
+        int tile_y = static_cast<int>(floorf(-ys[i] * m_inverse_tile_size));
+        int tile   = get_tile_type(tile_x, tile_y);
+
+        tile_types[i]    = tile;
+        penetration_x[i] = 0.0f;
+        penetration_y[i] = 0.0f;
+        if (tile <= 0) continue;
+
+        penetration_x[i] = half_tile - fabsf(xs[i] - (tile_x * m_tile_size + half_tile));
+        penetration_y[i] = half_tile - fabsf(ys[i] + (tile_y * m_tile_size + half_tile));
+
+        if (results.solid_bits) results.solid_bits[i / 32] |= 1u << (i % 32);
+        solid_count++;
+    }
+
+    return solid_count;
+}
+
+
+// ————— RAYCASTS ————— //
+// Amanatides & Woo traversal in grid space, where a tile is 1x1 and y grows
+// downwards like the level data. The ray is first clipped to the map so a
+// start point outside it still finds the tiles it runs into. Whenever the
+// occupancy pyramid says the tile sits in a bigger empty block, the ray jumps
+// straight to where it leaves that block.
+static void raycast_grid(const unsigned int *level, const OccupancyPyramid &occupancy,
+                         int width, int height, float tile_size,
+                         float inverse_tile_size, float origin_x, float origin_y,
+                         float direction_x, float direction_y, float max_distance,
+                         Map::RaycastHit *hit)
+{
+    *hit = Map::RaycastHit();
+
+    float length = sqrtf(direction_x * direction_x + direction_y * direction_y);
+    if (length == 0.0f) return;
+    direction_x /= length;
+    direction_y /= length;
+
+    float grid_x = origin_x * inverse_tile_size, grid_y = -origin_y * inverse_tile_size;
+    float step_x = direction_x,                  step_y = -direction_y;
+    float max_t  = max_distance * inverse_tile_size;
+
+    // Slab test against [0, width] x [0, height]; remember which face we came in by
+    float t_enter = 0.0f, t_exit = max_t;
+    float enter_normal_x = 0.0f, enter_normal_y = 0.0f;
+    float leave_x = INFINITY, leave_y = INFINITY;  // when the ray crosses the width/height faces outwards
+
+    float inverse_x = step_x != 0.0f ? 1.0f / step_x : INFINITY;
+    float near_x = (step_x >= 0.0f ? 0.0f : width) - grid_x,  far_x = (step_x >= 0.0f ? width : 0.0f) - grid_x;
+    if (step_x == 0.0f) { if (grid_x < 0.0f || grid_x >= width) return; }
+    else
+    {
+        float t0 = near_x * inverse_x, t1 = far_x * inverse_x;
+        if (t0 > t_enter) { t_enter = t0; enter_normal_x = step_x > 0.0f ? -1.0f : 1.0f; }
+        t_exit  = fminf(t_exit, t1);
+        if (step_x > 0.0f) leave_x = t1;
+    }
+
+    float inverse_y = step_y != 0.0f ? 1.0f / step_y : INFINITY;
+    float near_y = (step_y >= 0.0f ? 0.0f : height) - grid_y, far_y = (step_y >= 0.0f ? height : 0.0f) - grid_y;
+    if (step_y == 0.0f) { if (grid_y < 0.0f || grid_y >= height) return; }
+    else
+    {
+        float t0 = near_y * inverse_y, t1 = far_y * inverse_y;
+        if (t0 > t_enter) { t_enter = t0; enter_normal_x = 0.0f; enter_normal_y = step_y > 0.0f ? 1.0f : -1.0f; }
+        t_exit  = fminf(t_exit, t1);
+        if (step_y > 0.0f) leave_y = t1;
+    }
+
+    if (t_enter > t_exit) return;
+
+    // Tiles are half-open, so the width/height faces aren't part of the map:
+    // a ray that's already leaving through one of them when it enters (say,
+    // starting on the far edge and pointing away) crosses no tile at all, and
+    // the clamp below would otherwise drag it back into the edge tile
+    if (leave_x <= t_enter || leave_y <= t_enter) return;
+
+    // Starting tile, clamped so an entry exactly on the far edge stays inside
+    float t = t_enter;
+    int cell_x = std::min(std::max((int) floorf(grid_x + step_x * t), 0), width - 1);
+    int cell_y = std::min(std::max((int) floorf(grid_y + step_y * t), 0), height - 1);
+
+    int   direction_cell_x = step_x > 0.0f ? 1 : -1;
+    int   direction_cell_y = step_y > 0.0f ? 1 : -1;
+    float delta_x = fabsf(inverse_x), delta_y = fabsf(inverse_y);
+    float next_x  = step_x == 0.0f ? INFINITY : ((cell_x + (step_x > 0.0f)) - grid_x) * inverse_x;
+    float next_y  = step_y == 0.0f ? INFINITY : ((cell_y + (step_y > 0.0f)) - grid_y) * inverse_y;
+
+    float normal_x = enter_normal_x, normal_y = enter_normal_y;
+
+    while (true)
+    {
+        int tile = (int) level[cell_y * width + cell_x];
+        if (tile > 0)
+        {
+            hit->hit       = true;
+            hit->distance  = t * tile_size;
+            hit->x         = origin_x + direction_x * hit->distance;
+            hit->y         = origin_y + direction_y * hit->distance;
+            hit->tile_x    = cell_x;
+            hit->tile_y    = cell_y;
+            hit->tile_type = tile;
+            hit->normal_x  = normal_x;
+            hit->normal_y  = normal_y;
+            return;
+        }
+
+        // Sky: leave the whole empty block in one go, then pick the DDA back
+        // up from the tile on the other side
+        int empty_level = occupancy.largest_empty_level(cell_x, cell_y);
+        if (empty_level > 0)
+        {
+            int size    = 1 << empty_level;
+            int block_x = (cell_x >> empty_level) << empty_level;
+            int block_y = (cell_y >> empty_level) << empty_level;
+
+            float exit_x = step_x == 0.0f ? INFINITY : ((block_x + (step_x > 0.0f ? size : 0)) - grid_x) * inverse_x;
+            float exit_y = step_y == 0.0f ? INFINITY : ((block_y + (step_y > 0.0f ? size : 0)) - grid_y) * inverse_y;
+
+            if (exit_x < exit_y)
+            {
+                t = exit_x;
+                cell_x = step_x > 0.0f ? block_x + size : block_x - 1;
+                cell_y = std::min(std::max((int) floorf(grid_y + step_y * t), std::max(block_y, 0)),
+                                  std::min(block_y + size, height) - 1);
+                normal_x = (float) -direction_cell_x;
+                normal_y = 0.0f;
+            }
+            else
+            {
+                t = exit_y;
+                cell_y = step_y > 0.0f ? block_y + size : block_y - 1;
+                cell_x = std::min(std::max((int) floorf(grid_x + step_x * t), std::max(block_x, 0)),
+                                  std::min(block_x + size, width) - 1);
+                normal_x = 0.0f;
+                normal_y = (float) direction_cell_y;
+            }
+
+            if (cell_x < 0 || cell_x >= width || cell_y < 0 || cell_y >= height || t > t_exit) return;
+
+            next_x = step_x == 0.0f ? INFINITY : ((cell_x + (step_x > 0.0f)) - grid_x) * inverse_x;
+            next_y = step_y == 0.0f ? INFINITY : ((cell_y + (step_y > 0.0f)) - grid_y) * inverse_y;
+            continue;
+        }
+
+        // Step into whichever neighbour the ray reaches first. In world space
+        // the face crossed points back along the step (and y is flipped).
+        if (next_x < next_y)
+        {
+            t = next_x;
+            next_x += delta_x;
+            cell_x += direction_cell_x;
+            normal_x = (float) -direction_cell_x;
+            normal_y = 0.0f;
+            if (cell_x < 0 || cell_x >= width) return;
+        }
+        else
+        {
+            t = next_y;
+            next_y += delta_y;
+            cell_y += direction_cell_y;
+            normal_x = 0.0f;
+            normal_y = (float) direction_cell_y;
+            if (cell_y < 0 || cell_y >= height) return;
+        }
+
+        if (t > t_exit) return;
+    }
+}
+
+Map::RaycastHit Map::raycast(glm::vec3 origin, glm::vec3 direction, float max_distance) const
+{
+    RaycastHit hit;
+    raycast_grid(m_level_data, m_occupancy, m_width, m_height, m_tile_size, m_inverse_tile_size,
+                 origin.x, origin.y, direction.x, direction.y, max_distance, &hit);
+    return hit;
+}
+
+void Map::raycast_batch(const float *origin_x, const float *origin_y,
+                        const float *direction_x, const float *direction_y,
+                        int count, float max_distance, RaycastHit *hits) const
+{
+    for (int i = 0; i < count; i++)
+    {
+        raycast_grid(m_level_data, m_occupancy, m_width, m_height, m_tile_size, m_inverse_tile_size,
+                     origin_x[i], origin_y[i], direction_x[i], direction_y[i], max_distance, &hits[i]);
+    }
+}
+
+
+// ————— DISTANCE FIELDS ————— //
+static bool is_solid_tile(unsigned int tile) { return tile != 0; }
+static bool is_empty_tile(unsigned int tile) { return tile == 0; }
+static bool is_pad_tile(unsigned int tile)   { return tile == Map::LANDING_PAD_TILE; }
+
+void Map::build_distance_fields()
+{
+    m_solid_field.build(m_level_data, m_width, m_height, is_solid_tile);
+    m_empty_field.build(m_level_data, m_width, m_height, is_empty_tile);
+    m_pad_field.build(m_level_data, m_width, m_height, is_pad_tile);
+}
+
+// The fields measure centre to centre; half a tile less is the distance to
+// the near edge of the nearest one (exact along the axes, a little long on
+// the diagonals)
+float Map::get_solid_distance(int x, int y) const
+{
+    if (m_level_data[y * m_width + x] == 0) return (m_solid_field.get(x, y) - 0.5f) * m_tile_size;
+    return -(m_empty_field.get(x, y) - 0.5f) * m_tile_size;
+}
+
+float Map::get_pad_distance(int x, int y) const
+{
+    return std::max(0.0f, m_pad_field.get(x, y) - 0.5f) * m_tile_size;
+}
+
+float Map::sample_field(glm::vec3 position, bool signed_solid) const
+{
+    // Tile-centre coordinates, clamped to the map
+    float grid_x = std::min(std::max(position.x * m_inverse_tile_size - 0.5f, 0.0f), (float) (m_width - 1));
+    float grid_y = std::min(std::max(-position.y * m_inverse_tile_size - 0.5f, 0.0f), (float) (m_height - 1));
+
+    int   x0 = (int) grid_x,                 y0 = (int) grid_y;
+    int   x1 = std::min(x0 + 1, m_width - 1), y1 = std::min(y0 + 1, m_height - 1);
+    float fx = grid_x - x0,                  fy = grid_y - y0;
+
+    float d00, d10, d01, d11;
+    if (signed_solid)
+    {
+        d00 = get_solid_distance(x0, y0); d10 = get_solid_distance(x1, y0);
+        d01 = get_solid_distance(x0, y1); d11 = get_solid_distance(x1, y1);
+    }
+    else
+    {
+        d00 = get_pad_distance(x0, y0); d10 = get_pad_distance(x1, y0);
+        d01 = get_pad_distance(x0, y1); d11 = get_pad_distance(x1, y1);
+    }
+
+    float top    = d00 + (d10 - d00) * fx;
+    float bottom = d01 + (d11 - d01) * fx;
+    return top + (bottom - top) * fy;
+}
+
+void Map::set_tile(int x, int y, unsigned int tile)
+{
+    if (x < 0 || x >= m_width || y < 0 || y >= m_height) return;
+    if (m_level_data[y * m_width + x] == tile) return;
+
+    m_level_data[y * m_width + x] = tile;
+    build();
+
+    m_occupancy.update_tile(m_level_data, x, y);
+
+    m_solid_field.update_tile(m_level_data, x, y);
+    m_empty_field.update_tile(m_level_data, x, y);
+    m_pad_field.update_tile(m_level_data, x, y);
+}
+
+
+bool Map::is_region_empty(glm::vec3 min, glm::vec3 max) const
+{
+    // World y runs up, tile y runs down
+    int min_x = (int) floorf(min.x * m_inverse_tile_size);
+    int max_x = (int) floorf(max.x * m_inverse_tile_size);
+    int min_y = (int) floorf(-max.y * m_inverse_tile_size);
+    int max_y = (int) floorf(-min.y * m_inverse_tile_size);
+
+    return !m_occupancy.any_solid(min_x, min_y, max_x, max_y);
+}
+
 
 // Function to get tile type at specific coordinates
-int Map::get_tile_type(int x, int y) {
+int Map::get_tile_type(int x, int y) const {
     if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
         return -1;  // Out of bounds
     }
@@ -12,9 +12,38 @@
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "ShaderProgram.h"
+#include "DistanceField.h"
+#include "OccupancyPyramid.h"
+
+class Mesh;
 
 class Map
 {
+public:
+    // Where is_solid_batch writes its answers, one entry per probe.
+    // solid_bits is optional: bit (i % 32) of word (i / 32) is set when probe
+    // i hit a solid tile, so callers can skip straight to the hits.
+    struct ProbeResults
+    {
+        int          *tile_types    = nullptr;  // -1 outside the map, 0 empty
+        float        *penetration_x = nullptr;  // 0 unless solid
+        float        *penetration_y = nullptr;
+        unsigned int *solid_bits    = nullptr;  // (count + 31) / 32 words
+    };
+
+    // First solid tile along a ray. distance is in world units along the
+    // normalised direction; the normal is the face that was crossed, or zero
+    // when the ray started inside a solid tile.
+    struct RaycastHit
+    {
+        bool  hit = false;
+        float distance = 0.0f;
+        float x = 0.0f, y = 0.0f;  // hit point
+        int   tile_x = -1, tile_y = -1;
+        int   tile_type = -1;
+        float normal_x = 0.0f, normal_y = 0.0f;
+    };
+
 private:
     int m_width;
     int m_height;
@@ -24,6 +53,7 @@ private:
     GLuint m_texture_id, tile1_texture_id;
     
     float m_tile_size;
+    float m_inverse_tile_size;  // probes multiply instead of dividing
     int   m_tile_count_x;
     int   m_tile_count_y;
     
@@ -32,18 +62,48 @@ private:
     std::vector<float> m_vertices;
     std::vector<float> m_texture_coordinates;
     
+    // GPU copy of the above, uploaded on the first render after a build
+    Mesh *m_mesh       = nullptr;
+    bool  m_mesh_dirty = true;
+    
     // The boundaries of the map
     float m_left_bound, m_right_bound, m_top_bound, m_bottom_bound;
+
+    // Which blocks of the map hold anything solid, for skipping empty space
+    OccupancyPyramid m_occupancy;
+
+    // ————— DISTANCE FIELDS ————— //
+    // Only built on request; set_tile keeps them current afterwards
+    DistanceField m_solid_field;  // empty tiles: how far to solid ground
+    DistanceField m_empty_field;  // solid tiles: how far to open space
+    DistanceField m_pad_field;    // every tile: how far to a landing pad
+
+    float sample_field(glm::vec3 position, bool signed_solid) const;
     
 public:
     // Constructor
     Map(int width, int height, unsigned int *level_data, GLuint texture_id,
         float tile_size, int tile_count_x, int tile_count_y);
+    ~Map();
+    
+    Map(const Map&) = delete;
+    Map& operator=(const Map&) = delete;
     
     // Methods
     void build();
     void render(ShaderProgram *program);
     bool is_solid(glm::vec3 position, float *penetration_x, float *penetration_y);
+
+    // is_solid over `count` points at once (say every probe of every entity
+    // this step), four at a time with SIMD. Returns how many were solid.
+    int is_solid_batch(const float *xs, const float *ys, int count, const ProbeResults &results) const;
+
+    // Walks the tiles a ray passes through (DDA), so the cost is the number
+    // of tiles crossed rather than the size of the map
+    RaycastHit raycast(glm::vec3 origin, glm::vec3 direction, float max_distance) const;
+    void raycast_batch(const float *origin_x, const float *origin_y,
+                       const float *direction_x, const float *direction_y,
+                       int count, float max_distance, RaycastHit *hits) const;
     
     // Getters
     int const get_width()  const  { return m_width;  }
@@ -56,15 +116,40 @@ public:
     int   const get_tile_count_x() const { return m_tile_count_x; }
     int   const get_tile_count_y() const { return m_tile_count_y; }
     
-    std::vector<float> const get_vertices()            const { return m_vertices;             }
-    std::vector<float> const get_texture_coordinates() const { return m_texture_coordinates; }
+    const std::vector<float>& get_vertices()            const { return m_vertices;            }
+    const std::vector<float>& get_texture_coordinates() const { return m_texture_coordinates; }
     
     float const get_left_bound()   const { return m_left_bound;   }
     float const get_right_bound()  const { return m_right_bound;  }
     float const get_top_bound()    const { return m_top_bound;    }
     float const get_bottom_bound() const { return m_bottom_bound; }
     
-    int get_tile_type(int x, int y);
+    int get_tile_type(int x, int y) const;
+
+    // Changes one tile, rebuilding the mesh and updating the occupancy
+    // pyramid and any distance fields
+    void set_tile(int x, int y, unsigned int tile);
+
+    // True when no solid tile touches the world-space box, answered from the
+    // occupancy pyramid in a few lookups however big the box is
+    bool is_region_empty(glm::vec3 min, glm::vec3 max) const;
+    const OccupancyPyramid& get_occupancy() const { return m_occupancy; }
+
+    // ————— DISTANCE FIELDS ————— //
+    static constexpr unsigned int LANDING_PAD_TILE = 3;
+
+    void build_distance_fields();
+    bool const has_distance_fields() const { return m_solid_field.is_built(); }
+
+    // Signed distance from a tile to the nearest solid tile's edge, in world
+    // units: positive in open space, negative inside the ground
+    float get_solid_distance(int x, int y) const;
+    float get_pad_distance(int x, int y) const;
+
+    // The same, bilinearly interpolated between tile centres for any point.
+    // Outside the map, the nearest edge tile answers.
+    float solid_distance(glm::vec3 position) const { return sample_field(position, true);  }
+    float pad_distance(glm::vec3 position)   const { return sample_field(position, false); }
 
 };
 
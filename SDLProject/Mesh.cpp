@@ -0,0 +1,132 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "Mesh.h"
+#include "ShaderProgram.h"
+
+namespace
+{
+    Mesh *g_unit_quad = nullptr;
+}
+
+Mesh::Mesh(GLenum usage) : m_usage(usage) { }
+
+Mesh::~Mesh()
+{
+    if (m_vertex_buffer != 0) GLState::delete_buffer(m_vertex_buffer);
+#ifndef USE_LEGACY_GL
+    if (m_vertex_array != 0) GLState::delete_vertex_array(m_vertex_array);
+#endif
+}
+
+void Mesh::describe_attributes()
+{
+    const GLsizei stride = FLOATS_PER_VERTEX * sizeof(float);
+
+    glVertexAttribPointer(ShaderProgram::POSITION_ATTRIBUTE, 2, GL_FLOAT, false, stride,
+                          (const void*) 0);
+    glVertexAttribPointer(ShaderProgram::TEX_COORD_ATTRIBUTE, 2, GL_FLOAT, false, stride,
+                          (const void*) (2 * sizeof(float)));
+}
+
+void Mesh::create()
+{
+    glGenBuffers(1, &m_vertex_buffer);
+
+#ifndef USE_LEGACY_GL
+    // Attribute enables are part of the VAO, so they're set directly here
+    // rather than through GLState, which only tracks the default VAO
+    glGenVertexArrays(1, &m_vertex_array);
+    GLState::bind_vertex_array(m_vertex_array);
+    GLState::bind_array_buffer(m_vertex_buffer);
+
+    describe_attributes();
+    glEnableVertexAttribArray(ShaderProgram::POSITION_ATTRIBUTE);
+    glEnableVertexAttribArray(ShaderProgram::TEX_COORD_ATTRIBUTE);
+
+    GLState::bind_vertex_array(0);
+#endif
+}
+
+void Mesh::reserve(int vertex_count)
+{
+    if (m_vertex_buffer == 0) create();
+
+    GLState::bind_array_buffer(m_vertex_buffer);
+    glBufferData(GL_ARRAY_BUFFER, vertex_count * FLOATS_PER_VERTEX * sizeof(float), nullptr, m_usage);
+
+    m_vertex_capacity = vertex_count;
+    m_vertex_count    = 0;
+}
+
+void Mesh::upload(const float *vertices, int vertex_count)
+{
+    if (m_vertex_buffer == 0) create();
+
+    GLState::bind_array_buffer(m_vertex_buffer);
+    glBufferData(GL_ARRAY_BUFFER, vertex_count * FLOATS_PER_VERTEX * sizeof(float), vertices, m_usage);
+
+    m_vertex_capacity = vertex_count;
+    m_vertex_count    = vertex_count;
+}
+
+void Mesh::update(const float *vertices, int vertex_count)
+{
+    if (vertex_count > m_vertex_capacity)
+    {
+        upload(vertices, vertex_count);
+        return;
+    }
+
+    GLState::bind_array_buffer(m_vertex_buffer);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertex_count * FLOATS_PER_VERTEX * sizeof(float), vertices);
+
+    m_vertex_count = vertex_count;
+}
+
+void Mesh::draw(GLenum mode) const
+{
+    draw(mode, 0, m_vertex_count);
+}
+
+void Mesh::draw(GLenum mode, int first, int count) const
+{
+    if (count <= 0) return;
+
+#ifdef USE_LEGACY_GL
+    GLState::bind_array_buffer(m_vertex_buffer);
+    describe_attributes();
+    GLState::enable_attribute(ShaderProgram::POSITION_ATTRIBUTE);
+    GLState::enable_attribute(ShaderProgram::TEX_COORD_ATTRIBUTE);
+#else
+    GLState::bind_vertex_array(m_vertex_array);
+#endif
+
+    GLState::draw_arrays(mode, first, count);
+}
+
+Mesh* Mesh::unit_quad()
+{
+    if (g_unit_quad == nullptr)
+    {
+        float vertices[] =
+        {
+            -0.5f, -0.5f, 0.0f, 1.0f,
+             0.5f, -0.5f, 1.0f, 1.0f,
+             0.5f,  0.5f, 1.0f, 0.0f,
+            -0.5f, -0.5f, 0.0f, 1.0f,
+             0.5f,  0.5f, 1.0f, 0.0f,
+            -0.5f,  0.5f, 0.0f, 0.0f,
+        };
+
+        g_unit_quad = new Mesh(GL_STATIC_DRAW);
+        g_unit_quad->upload(vertices, 6);
+    }
+
+    return g_unit_quad;
+}
+
+void Mesh::release_shared()
+{
+    delete g_unit_quad;
+    g_unit_quad = nullptr;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "GLState.h"
+
+// Interleaved (x, y, u, v) triangles held in a GPU buffer. On the core-profile
+// path the attribute layout is recorded once in a vertex array object; with
+// USE_LEGACY_GL the buffer is re-described before each draw instead.
+class Mesh
+{
+public:
+    static constexpr int FLOATS_PER_VERTEX = 4;
+
+private:
+    GLuint  m_vertex_array  = 0;
+    GLuint  m_vertex_buffer = 0;
+    GLenum  m_usage;
+    GLsizei m_vertex_count    = 0;
+    GLsizei m_vertex_capacity = 0;
+
+    void create();
+
+public:
+    // ————— CONSTRUCTORS ————— //
+    explicit Mesh(GLenum usage = GL_STATIC_DRAW);
+    ~Mesh();
+
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
+    // ————— METHODS ————— //
+    // Replaces the buffer's storage with `vertex_count` vertices
+    void upload(const float *vertices, int vertex_count);
+    // Allocates room for `vertex_count` vertices without filling it
+    void reserve(int vertex_count);
+    // Overwrites the start of the buffer, growing it only if it's too small
+    void update(const float *vertices, int vertex_count);
+
+    void draw(GLenum mode = GL_TRIANGLES) const;
+    void draw(GLenum mode, int first, int count) const;
+
+    // Points the position/texCoord attributes at the currently bound buffer
+    static void describe_attributes();
+
+    GLsizei const get_vertex_count()    const { return m_vertex_count;    }
+    GLsizei const get_vertex_capacity() const { return m_vertex_capacity; }
+    GLuint  const get_buffer_id()       const { return m_vertex_buffer;   }
+
+    // A shared 1x1 quad centred on the origin, with the texture's top row at the top
+    static Mesh* unit_quad();
+    static void  release_shared();
+};
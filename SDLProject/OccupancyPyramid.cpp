@@ -0,0 +1,120 @@
+#include "OccupancyPyramid.h"
+#include <algorithm>
+
+// A cell from its (up to) four children; missing children are empty
+uint8_t OccupancyPyramid::combine(int level, int x, int y) const
+{
+    uint8_t any = 0, all = ALL_SOLID;
+    for (int child = 0; child < 4; child++)
+    {
+        uint8_t cell = get_cell(level - 1, x * 2 + (child & 1), y * 2 + (child >> 1));
+        any |= cell & ANY_SOLID;
+        all &= cell;
+    }
+    return any | (all & ALL_SOLID);
+}
+
+void OccupancyPyramid::build(const unsigned int *level_data, int width, int height)
+{
+    m_levels.clear();
+
+    Level base;
+    base.width  = width;
+    base.height = height;
+    base.cells.resize(width * height);
+    for (int i = 0; i < width * height; i++) base.cells[i] = level_data[i] != 0 ? ANY_SOLID | ALL_SOLID : 0;
+    m_levels.push_back(base);
+
+    // Halve (rounding up) until one cell covers the whole map
+    while (m_levels.back().width > 1 || m_levels.back().height > 1)
+    {
+        Level next;
+        next.width  = (m_levels.back().width  + 1) / 2;
+        next.height = (m_levels.back().height + 1) / 2;
+        next.cells.resize(next.width * next.height);
+        m_levels.push_back(next);
+
+        int level = (int) m_levels.size() - 1;
+        Level &current = m_levels[level];
+        for (int y = 0; y < current.height; y++)
+        {
+            for (int x = 0; x < current.width; x++) current.cells[y * current.width + x] = combine(level, x, y);
+        }
+    }
+}
+
+void OccupancyPyramid::update_tile(const unsigned int *level_data, int x, int y)
+{
+    if (m_levels.empty()) return;
+
+    Level &base = m_levels[0];
+    if (x < 0 || y < 0 || x >= base.width || y >= base.height) return;
+    base.cells[y * base.width + x] = level_data[y * base.width + x] != 0 ? ANY_SOLID | ALL_SOLID : 0;
+
+    // Walk up, stopping as soon as a cell comes out the same as before
+    for (int level = 1; level < (int) m_levels.size(); level++)
+    {
+        x /= 2;
+        y /= 2;
+
+        Level  &current = m_levels[level];
+        uint8_t cell    = combine(level, x, y);
+        if (current.cells[y * current.width + x] == cell) break;
+        current.cells[y * current.width + x] = cell;
+    }
+}
+
+// Descends only into cells that both overlap the rectangle and hold something
+bool OccupancyPyramid::region_has_solid(int level, int x, int y, int min_x, int min_y, int max_x, int max_y) const
+{
+    uint8_t cell = get_cell(level, x, y);
+    if (!(cell & ANY_SOLID)) return false;
+
+    int first_x = x << level, last_x = ((x + 1) << level) - 1;
+    int first_y = y << level, last_y = ((y + 1) << level) - 1;
+    if (last_x < min_x || first_x > max_x || last_y < min_y || first_y > max_y) return false;
+
+    bool covered = first_x >= min_x && last_x <= max_x && first_y >= min_y && last_y <= max_y;
+    if (level == 0 || covered || (cell & ALL_SOLID)) return true;
+
+    for (int child = 0; child < 4; child++)
+    {
+        if (region_has_solid(level - 1, x * 2 + (child & 1), y * 2 + (child >> 1), min_x, min_y, max_x, max_y))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool OccupancyPyramid::any_solid(int min_x, int min_y, int max_x, int max_y) const
+{
+    if (m_levels.empty()) return false;
+
+    min_x = std::max(min_x, 0);
+    min_y = std::max(min_y, 0);
+    max_x = std::min(max_x, m_levels[0].width - 1);
+    max_y = std::min(max_y, m_levels[0].height - 1);
+    if (min_x > max_x || min_y > max_y) return false;
+
+    // A lander-sized rectangle is cheaper to read straight off the tiles
+    if ((max_x - min_x + 1) * (max_y - min_y + 1) <= 4)
+    {
+        const Level &base = m_levels[0];
+        for (int y = min_y; y <= max_y; y++)
+        {
+            for (int x = min_x; x <= max_x; x++)
+            {
+                if (base.cells[y * base.width + x] & ANY_SOLID) return true;
+            }
+        }
+        return false;
+    }
+
+    // Otherwise start from the smallest cell holding the whole rectangle
+    // rather than the top
+    int level = 0;
+    while ((min_x >> level) != (max_x >> level) || (min_y >> level) != (max_y >> level)) level++;
+
+    return region_has_solid(level, min_x >> level, min_y >> level, min_x, min_y, max_x, max_y);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+// A mip chain over the tile map. Level 0 has one cell per tile, and each cell
+// of level k covers a 2x2 block of level k - 1, so a level-k cell covers
+// 2^k x 2^k tiles. Every cell records whether any tile under it is solid
+// (max) and whether all of them are (min). Tiles past the map's edge count
+// as empty.
+//
+// Mostly-empty levels collapse to a few "nothing here" cells near the top,
+// so rays and region queries can skip whole blocks of sky at once.
+class OccupancyPyramid
+{
+public:
+    enum CellBits : uint8_t { ANY_SOLID = 1 << 0, ALL_SOLID = 1 << 1 };
+
+private:
+    struct Level
+    {
+        int width, height;
+        std::vector<uint8_t> cells;
+    };
+
+    std::vector<Level> m_levels;
+
+    uint8_t combine(int level, int x, int y) const;
+    bool    region_has_solid(int level, int x, int y, int min_x, int min_y, int max_x, int max_y) const;
+
+public:
+    OccupancyPyramid() { }
+
+    void build(const unsigned int *level_data, int width, int height);
+
+    // Call after level_data[y * width + x] changed; fixes up one cell per level
+    void update_tile(const unsigned int *level_data, int x, int y);
+
+    int     const get_level_count() const { return (int) m_levels.size(); }
+    uint8_t const get_cell(int level, int x, int y) const
+    {
+        const Level &l = m_levels[level];
+        if (x < 0 || y < 0 || x >= l.width || y >= l.height) return 0;
+        return l.cells[y * l.width + x];
+    }
+
+    // The biggest block around an empty tile with nothing solid in it, as a
+    // level number (0 means just the tile itself)
+    int largest_empty_level(int tile_x, int tile_y) const
+    {
+        int level = 0;
+        while (level + 1 < (int) m_levels.size() &&
+               !(get_cell(level + 1, tile_x >> (level + 1), tile_y >> (level + 1)) & ANY_SOLID))
+        {
+            level++;
+        }
+        return level;
+    }
+
+    // Any solid tile in the inclusive tile rectangle?
+    bool any_solid(int min_x, int min_y, int max_x, int max_y) const;
+};
@@ -0,0 +1,171 @@
+#include "ParticleSystem.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PARTICLES_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PARTICLES_NEON
+#endif
+
+ParticleSystem::ParticleSystem(int capacity)
+    : m_capacity(capacity)
+{
+    int padded = (capacity + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+
+    std::vector<float>* arrays[] = { &m_x, &m_y, &m_velocity_x, &m_velocity_y, &m_life, &m_fade,
+                                     &m_size, &m_red, &m_green, &m_blue, &m_alpha };
+    for (std::vector<float> *array : arrays) array->assign(padded, 0.0f);
+}
+
+// xorshift32; plenty for scattering particles and never touches the heap
+float ParticleSystem::random_signed()
+{
+    m_random_state ^= m_random_state << 13;
+    m_random_state ^= m_random_state >> 17;
+    m_random_state ^= m_random_state << 5;
+    return (float) (m_random_state >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+int ParticleSystem::emit(const Emitter &emitter, int count)
+{
+    count = std::min(count, m_capacity - m_count);
+
+    for (int i = m_count; i < m_count + count; i++)
+    {
+        m_x[i] = emitter.x + emitter.position_jitter * random_signed();
+        m_y[i] = emitter.y + emitter.position_jitter * random_signed();
+
+        m_velocity_x[i] = emitter.velocity_x + emitter.velocity_jitter * random_signed();
+        m_velocity_y[i] = emitter.velocity_y + emitter.velocity_jitter * random_signed();
+
+        float life = std::max(0.01f, emitter.life + emitter.life_jitter * random_signed());
+        m_life[i] = life;
+        m_fade[i] = 1.0f / life;
+        m_size[i] = emitter.size;
+
+        m_red[i]   = emitter.red;
+        m_green[i] = emitter.green;
+        m_blue[i]  = emitter.blue;
+        m_alpha[i] = emitter.alpha;
+    }
+
+    m_count += count;
+    return count;
+}
+
+void ParticleSystem::update(float delta_time)
+{
+    if (m_count == 0) return;
+
+    integrate(delta_time);
+    remove_dead();
+}
+
+// Semi-implicit Euler with linear drag. Lanes past m_count hold stale (but
+// finite) values, so running whole blocks over them is harmless.
+void ParticleSystem::integrate(float delta_time)
+{
+    int   blocks   = (m_count + SIMD_WIDTH - 1) / SIMD_WIDTH;
+    float damping  = std::max(0.0f, 1.0f - m_drag * delta_time);
+    float fall     = m_gravity * delta_time;
+
+    float *x = m_x.data(), *y = m_y.data();
+    float *velocity_x = m_velocity_x.data(), *velocity_y = m_velocity_y.data();
+    float *life = m_life.data();
+
+#if defined(PARTICLES_SSE2)
+    const __m128 dt4      = _mm_set1_ps(delta_time);
+    const __m128 damping4 = _mm_set1_ps(damping);
+    const __m128 fall4    = _mm_set1_ps(fall);
+
+    for (int i = 0; i < blocks * SIMD_WIDTH; i += SIMD_WIDTH)
+    {
+        __m128 vx = _mm_mul_ps(_mm_loadu_ps(velocity_x + i), damping4);
+        __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(velocity_y + i), fall4), damping4);
+
+        _mm_storeu_ps(velocity_x + i, vx);
+        _mm_storeu_ps(velocity_y + i, vy);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(vx, dt4)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(vy, dt4)));
+        _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), dt4));
+    }
+#elif defined(PARTICLES_NEON)
+    const float32x4_t dt4      = vdupq_n_f32(delta_time);
+    const float32x4_t damping4 = vdupq_n_f32(damping);
+    const float32x4_t fall4    = vdupq_n_f32(fall);
+
+    for (int i = 0; i < blocks * SIMD_WIDTH; i += SIMD_WIDTH)
+    {
+        float32x4_t vx = vmulq_f32(vld1q_f32(velocity_x + i), damping4);
+        float32x4_t vy = vmulq_f32(vaddq_f32(vld1q_f32(velocity_y + i), fall4), damping4);
+
+        vst1q_f32(velocity_x + i, vx);
+        vst1q_f32(velocity_y + i, vy);
+        vst1q_f32(x + i, vmlaq_f32(vld1q_f32(x + i), vx, dt4));
+        vst1q_f32(y + i, vmlaq_f32(vld1q_f32(y + i), vy, dt4));
+        vst1q_f32(life + i, vsubq_f32(vld1q_f32(life + i), dt4));
+    }
+#else
+    for (int i = 0; i < blocks * SIMD_WIDTH; i++)
+    {
+        velocity_x[i] *= damping;
+        velocity_y[i]  = (velocity_y[i] + fall) * damping;
+        x[i]    += velocity_x[i] * delta_time;
+        y[i]    += velocity_y[i] * delta_time;
+        life[i] -= delta_time;
+    }
+#endif
+}
+
+// Fills each dead slot with the last live particle
+void ParticleSystem::remove_dead()
+{
+    int i = 0;
+    while (i < m_count)
+    {
+        if (m_life[i] > 0.0f)
+        {
+            i++;
+            continue;
+        }
+
+        int last = --m_count;
+        m_x[i]          = m_x[last];
+        m_y[i]          = m_y[last];
+        m_velocity_x[i] = m_velocity_x[last];
+        m_velocity_y[i] = m_velocity_y[last];
+        m_life[i]       = m_life[last];
+        m_fade[i]       = m_fade[last];
+        m_size[i]       = m_size[last];
+        m_red[i]        = m_red[last];
+        m_green[i]      = m_green[last];
+        m_blue[i]       = m_blue[last];
+        m_alpha[i]      = m_alpha[last];
+    }
+}
+
+void ParticleSystem::fill_batch(SpriteBatch &batch) const
+{
+    int claimed;
+    SpriteBatch::Instance *out = batch.append(m_count, &claimed);
+
+    for (int i = 0; i < claimed; i++)
+    {
+        SpriteBatch::Instance &instance = out[i];
+        instance.x        = m_x[i];
+        instance.y        = m_y[i];
+        instance.rotation = 0.0f;
+        instance.scale_x  = m_size[i];
+        instance.scale_y  = m_size[i];
+        instance.u        = 0.0f;
+        instance.v        = 0.0f;
+        instance.width    = 1.0f;
+        instance.height   = 1.0f;
+        instance.red      = m_red[i];
+        instance.green    = m_green[i];
+        instance.blue     = m_blue[i];
+        instance.alpha    = m_alpha[i] * std::min(1.0f, m_life[i] * m_fade[i]);
+    }
+}
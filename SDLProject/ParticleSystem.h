@@ -0,0 +1,73 @@
+#pragma once
+#include <vector>
+#include "SpriteBatch.h"
+
+// Fixed pool of short-lived particles (exhaust, debris) stored as structure of
+// arrays, so the per-step integration runs four particles at a time with SSE2
+// or NEON (and plain loops anywhere else). Dead particles are replaced by the
+// last live one, so the live ones are always the first get_count() slots and
+// nothing is allocated after construction.
+class ParticleSystem
+{
+public:
+    static constexpr int DEFAULT_CAPACITY = 100000;
+    static constexpr int SIMD_WIDTH       = 4;
+
+    // How a burst of particles starts out; each particle gets the base values
+    // plus a uniform random offset of up to +-jitter
+    struct Emitter
+    {
+        float x = 0.0f, y = 0.0f;
+        float position_jitter = 0.0f;
+
+        float velocity_x = 0.0f, velocity_y = 0.0f;
+        float velocity_jitter = 0.0f;
+
+        float life = 1.0f, life_jitter = 0.0f;  // seconds
+        float size = 0.1f;
+
+        float red = 1.0f, green = 1.0f, blue = 1.0f, alpha = 1.0f;
+    };
+
+private:
+    int m_capacity;
+    int m_count = 0;
+
+    // ————— PARTICLES (SoA) ————— //
+    // Padded to a whole number of SIMD_WIDTH blocks so the vector loop never
+    // needs a scalar tail
+    std::vector<float> m_x, m_y;
+    std::vector<float> m_velocity_x, m_velocity_y;
+    std::vector<float> m_life, m_fade;  // fade = 1 / starting life, for the alpha ramp
+    std::vector<float> m_size;
+    std::vector<float> m_red, m_green, m_blue, m_alpha;
+
+    // ————— PHYSICS ————— //
+    float m_gravity = -2.0f;  // units/s^2
+    float m_drag    = 1.5f;   // fraction of velocity lost per second
+
+    unsigned m_random_state = 0x9e3779b9u;
+
+    float random_signed();  // uniform in [-1, 1]
+    void  integrate(float delta_time);
+    void  remove_dead();
+
+public:
+    // ————— CONSTRUCTORS ————— //
+    explicit ParticleSystem(int capacity = DEFAULT_CAPACITY);
+
+    // ————— METHODS ————— //
+    // Returns how many were emitted, which is fewer than `count` once the pool is full
+    int  emit(const Emitter &emitter, int count);
+    void update(float delta_time);
+    void clear() { m_count = 0; }
+
+    // Appends one tinted instance per live particle, fading out with age
+    void fill_batch(SpriteBatch &batch) const;
+
+    void set_gravity(float gravity) { m_gravity = gravity; }
+    void set_drag(float drag)       { m_drag = drag; }
+
+    int const get_count()    const { return m_count;    }
+    int const get_capacity() const { return m_capacity; }
+};
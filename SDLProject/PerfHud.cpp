@@ -0,0 +1,184 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "PerfHud.h"
+#include "GLState.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    // ————— LAYOUT (UI view units) ————— //
+    constexpr float LEFT   = 1.6f,
+                    RIGHT  = 4.9f,
+                    TOP    = 1.6f;   // just under the fuel readout
+
+    constexpr float FONT_SIZE    = 0.19f,
+                    FONT_SPACING = 0.0f,
+                    LINE_HEIGHT  = 0.24f;
+
+    constexpr float GRAPH_HEIGHT = 0.75f,
+                    GRAPH_BOTTOM = TOP - LINE_HEIGHT * PerfHud::LINE_COUNT - 0.1f - GRAPH_HEIGHT;
+
+    // Frame time that fills the graph, as a multiple of the budget
+    constexpr float GRAPH_RANGE = 2.0f;
+
+    // ————— PALETTE ————— //
+    // One texel per colour; bars pick theirs by UV so the graph stays one draw
+    enum PaletteColour { BACKDROP, GOOD, CLOSE, OVER, LINE, PALETTE_SIZE };
+
+    const unsigned char PALETTE[PALETTE_SIZE * 4] = {
+          0,   0,   0, 160,  // BACKDROP
+         60, 200,  90, 255,  // GOOD:  under 80% of the budget
+        230, 200,  60, 255,  // CLOSE: up to the budget
+        220,  60,  60, 255,  // OVER
+        255, 255, 255, 200,  // LINE
+    };
+
+    float palette_u(PaletteColour colour) { return (colour + 0.5f) / PALETTE_SIZE; }
+
+    // Two triangles, same winding as the rest of the game's quads
+    float* write_quad(float *out, float left, float bottom, float right, float top, PaletteColour colour)
+    {
+        float u = palette_u(colour), v = 0.5f;
+        const float quad[6 * Mesh::FLOATS_PER_VERTEX] = {
+            left,  top,    u, v,
+            left,  bottom, u, v,
+            right, top,    u, v,
+            right, bottom, u, v,
+            right, top,    u, v,
+            left,  bottom, u, v,
+        };
+        std::copy(quad, quad + 6 * Mesh::FLOATS_PER_VERTEX, out);
+        return out + 6 * Mesh::FLOATS_PER_VERTEX;
+    }
+}
+
+PerfHud::PerfHud(GLuint font_texture_id)
+    : m_graph_mesh(GL_DYNAMIC_DRAW)
+{
+    for (int i = 0; i < LINE_COUNT; i++)
+    {
+        m_lines[i] = new TextLabel(font_texture_id, FONT_SIZE, FONT_SPACING,
+                                   glm::vec3(LEFT + FONT_SIZE * 0.5f, TOP - FONT_SIZE * 0.5f - LINE_HEIGHT * i, 0.0f));
+    }
+
+    glGenTextures(1, &m_palette_texture_id);
+    GLState::bind_texture(m_palette_texture_id);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PALETTE_SIZE, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, PALETTE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+PerfHud::~PerfHud()
+{
+    for (TextLabel *line : m_lines) delete line;
+    glDeleteTextures(1, &m_palette_texture_id);
+}
+
+void PerfHud::record_frame(const FrameSample &sample)
+{
+    m_samples[m_next] = sample;
+    m_next = (m_next + 1) % HISTORY;
+    if (m_count < HISTORY) m_count++;
+}
+
+void PerfHud::update_text()
+{
+    if (m_count == 0) return;
+
+    // Percentiles over the whole history
+    for (int i = 0; i < m_count; i++) m_sorted[i] = m_samples[i].milliseconds;
+    std::sort(m_sorted, m_sorted + m_count);
+
+    float p50 = m_sorted[m_count / 2],
+          p95 = m_sorted[std::min(m_count - 1, m_count * 95 / 100)],
+          p99 = m_sorted[std::min(m_count - 1, m_count * 99 / 100)],
+          max = m_sorted[m_count - 1];
+
+    // Rolling averages over the last TEXT_REFRESH frames
+    int   recent = std::min(m_count, TEXT_REFRESH);
+    float milliseconds = 0.0f, steps = 0.0f, draws = 0.0f, binds = 0.0f, allocations = 0.0f;
+    for (int i = 1; i <= recent; i++)
+    {
+        const FrameSample &sample = m_samples[(m_next - i + HISTORY) % HISTORY];
+        milliseconds += sample.milliseconds;
+        steps        += sample.simulation_steps;
+        draws        += sample.draw_calls;
+        binds        += sample.texture_binds;
+        allocations  += sample.allocations;
+    }
+    milliseconds /= recent; steps /= recent; draws /= recent; binds /= recent; allocations /= recent;
+
+    char line[TextLabel::MAX_CHARACTERS + 1];
+
+    snprintf(line, sizeof(line), "%.2fms %dfps", milliseconds, milliseconds > 0.0f ? (int) (1000.0f / milliseconds + 0.5f) : 0);
+    m_lines[0]->set_text(line);
+    snprintf(line, sizeof(line), "p50 %.1f p95 %.1f", p50, p95);
+    m_lines[1]->set_text(line);
+    snprintf(line, sizeof(line), "p99 %.1f max %.1f", p99, max);
+    m_lines[2]->set_text(line);
+    snprintf(line, sizeof(line), "step %.1f draw %.0f", steps, draws);
+    m_lines[3]->set_text(line);
+    snprintf(line, sizeof(line), "bind %.0f alloc %.0f", binds, allocations);
+    m_lines[4]->set_text(line);
+}
+
+void PerfHud::build_graph()
+{
+    float *out = m_graph_vertices;
+
+    // Backdrop behind both the text and the graph
+    out = write_quad(out, LEFT - 0.05f, GRAPH_BOTTOM - 0.05f, RIGHT + 0.05f, TOP + 0.05f, BACKDROP);
+
+    // Oldest sample on the left, newest on the right
+    float bar_width = (RIGHT - LEFT) / HISTORY;
+    float full      = m_budget_milliseconds * GRAPH_RANGE;
+
+    for (int i = 0; i < HISTORY; i++)
+    {
+        float left = LEFT + bar_width * i;
+        float height = 0.0f;
+        PaletteColour colour = GOOD;
+
+        int age = HISTORY - 1 - i;  // 0 for the newest sample
+        if (age < m_count)
+        {
+            float milliseconds = m_samples[(m_next - 1 - age + HISTORY) % HISTORY].milliseconds;
+            height = GRAPH_HEIGHT * std::min(milliseconds / full, 1.0f);
+
+            if      (milliseconds > m_budget_milliseconds)        colour = OVER;
+            else if (milliseconds > m_budget_milliseconds * 0.8f) colour = CLOSE;
+        }
+
+        // Empty slots still get a (zero-height) quad so the vertex count never changes
+        out = write_quad(out, left, GRAPH_BOTTOM, left + bar_width, GRAPH_BOTTOM + height, colour);
+    }
+
+    float budget_y = GRAPH_BOTTOM + GRAPH_HEIGHT / GRAPH_RANGE;
+    write_quad(out, LEFT, budget_y - 0.005f, RIGHT, budget_y + 0.005f, LINE);
+}
+
+void PerfHud::render(ShaderProgram *program)
+{
+    if (!m_visible) return;
+
+    if (++m_frames_since_text >= TEXT_REFRESH)
+    {
+        update_text();
+        m_frames_since_text = 0;
+    }
+
+    build_graph();
+
+    if (m_graph_mesh.get_vertex_capacity() == 0) m_graph_mesh.reserve(GRAPH_VERTICES);
+    m_graph_mesh.update(m_graph_vertices, GRAPH_VERTICES);
+
+    program->set_model_transform(Transform2D());
+    program->reset_texture_rect();
+    GLState::bind_texture(m_palette_texture_id);
+    m_graph_mesh.draw();
+
+    for (TextLabel *line : m_lines) line->render(program);
+}
@@ -0,0 +1,76 @@
+#pragma once
+#define GL_SILENCE_DEPRECATION
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL.h>
+#include <SDL_opengl.h>
+#include "ShaderProgram.h"
+#include "TextLabel.h"
+#include "Mesh.h"
+
+// Performance overlay: rolling frame time, percentiles, per-frame counters and
+// a bar graph of recent frame times. Samples go into a fixed ring buffer every
+// frame whether or not it's showing, which is a handful of stores; the sorting
+// and text only happen while it's visible.
+class PerfHud
+{
+public:
+    static constexpr int HISTORY         = 240;  // frames kept for the graph and percentiles
+    static constexpr int TEXT_REFRESH    = 15;   // frames between text updates, so numbers stay readable
+    static constexpr int LINE_COUNT      = 5;
+    static constexpr int GRAPH_QUADS     = HISTORY + 2;  // bars, backdrop and the budget line
+    static constexpr int GRAPH_VERTICES  = GRAPH_QUADS * 6;
+
+    struct FrameSample
+    {
+        float milliseconds     = 0.0f;
+        int   simulation_steps = 0;
+        int   draw_calls       = 0;
+        int   texture_binds    = 0;
+        unsigned long allocations = 0;
+    };
+
+private:
+    // ————— HISTORY ————— //
+    FrameSample m_samples[HISTORY];
+    int m_next  = 0;
+    int m_count = 0;
+
+    float m_sorted[HISTORY];  // percentile scratch
+    float m_budget_milliseconds = 1000.0f / 60.0f;
+
+    bool m_visible = false;
+    int  m_frames_since_text = TEXT_REFRESH;
+
+    // ————— DRAWING ————— //
+    GLuint     m_palette_texture_id;
+    TextLabel *m_lines[LINE_COUNT];
+
+    float m_graph_vertices[GRAPH_VERTICES * Mesh::FLOATS_PER_VERTEX];
+    Mesh  m_graph_mesh;
+
+    void update_text();
+    void build_graph();
+
+public:
+    // ————— CONSTRUCTORS ————— //
+    explicit PerfHud(GLuint font_texture_id);
+    ~PerfHud();
+
+    PerfHud(const PerfHud&) = delete;
+    PerfHud& operator=(const PerfHud&) = delete;
+
+    // ————— METHODS ————— //
+    void record_frame(const FrameSample &sample);
+
+    // Expects the UI view matrix to be set
+    void render(ShaderProgram *program);
+
+    void toggle() { m_visible = !m_visible; m_frames_since_text = TEXT_REFRESH; }
+    bool const is_visible() const { return m_visible; }
+
+    // Frame time the graph marks as the budget; bars over it turn red
+    void set_budget(float milliseconds) { m_budget_milliseconds = milliseconds; }
+};
@@ -0,0 +1,200 @@
+#include "PolicyTable.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#ifndef _WINDOWS
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+constexpr char     PolicyTable::MAGIC[8];
+constexpr uint32_t PolicyTable::VERSION;
+constexpr float    PolicyTable::FUEL_QUANTUM;
+constexpr uint16_t PolicyTable::FUEL_UNLANDABLE;
+constexpr int      PolicyTable::MAX_ACTIONS;
+
+uint32_t PolicyTable::cell_count(const Header &header)
+{
+    uint32_t count = 1;
+    for (int axis = 0; axis < AXIS_COUNT; axis++) count *= header.counts[axis];
+    return count;
+}
+
+uint16_t PolicyTable::pack(int action, float fuel, bool landable)
+{
+    uint16_t quantised = FUEL_UNLANDABLE;
+    if (landable) quantised = (uint16_t) std::min(fuel / FUEL_QUANTUM + 0.5f, (float) (FUEL_UNLANDABLE - 1));
+    return (uint16_t) ((quantised << 4) | (action & 0xF));
+}
+
+void PolicyTable::close()
+{
+#ifndef _WINDOWS
+    if (m_mapping != nullptr) munmap(m_mapping, m_mapping_size);
+#endif
+    m_mapping      = nullptr;
+    m_mapping_size = 0;
+    m_storage.clear();
+    m_cells = nullptr;
+}
+
+// Checks a header against the size of the file it came from
+static bool is_valid(const PolicyTable::Header &header, size_t file_size)
+{
+    if (memcmp(header.magic, PolicyTable::MAGIC, sizeof(header.magic)) != 0) return false;
+    if (header.version != PolicyTable::VERSION || header.header_size != sizeof(PolicyTable::Header)) return false;
+    if (header.counts[PolicyTable::ANGLE] * 2 > (uint32_t) PolicyTable::MAX_ACTIONS) return false;
+
+    uint64_t cells = 1;
+    for (int axis = 0; axis < PolicyTable::AXIS_COUNT; axis++)
+    {
+        if (header.counts[axis] == 0 || !(header.step[axis] > 0.0f)) return false;
+        cells *= header.counts[axis];
+    }
+    return file_size == sizeof(PolicyTable::Header) + cells * sizeof(uint16_t);
+}
+
+// Every cell's action has to name one of the header's tilts, or lookup would
+// hand back an angle off the end of the axis. One pass at load keeps lookup
+// free of checks.
+static bool has_valid_actions(const PolicyTable::Header &header, const uint16_t *cells)
+{
+    const int action_count = (int) header.counts[PolicyTable::ANGLE] * 2;
+    const uint32_t count   = PolicyTable::cell_count(header);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if ((cells[i] & 0xF) >= action_count) return false;
+    }
+    return true;
+}
+
+bool PolicyTable::open(const char *path)
+{
+    close();
+
+#ifndef _WINDOWS
+    int file = ::open(path, O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat info;
+    void *mapping = MAP_FAILED;
+    if (fstat(file, &info) == 0 && (size_t) info.st_size >= sizeof(Header))
+    {
+        mapping = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    ::close(file);  // the mapping keeps its own reference
+    if (mapping == MAP_FAILED) return false;
+
+    memcpy(&m_header, mapping, sizeof(Header));
+    if (!is_valid(m_header, (size_t) info.st_size))
+    {
+        munmap(mapping, (size_t) info.st_size);
+        return false;
+    }
+
+    m_mapping      = mapping;
+    m_mapping_size = (size_t) info.st_size;
+    m_cells        = (const uint16_t *) ((const char *) mapping + sizeof(Header));
+#else
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) return false;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    bool valid = size >= (long) sizeof(Header) && fread(&m_header, sizeof(Header), 1, file) == 1 &&
+                 is_valid(m_header, (size_t) size);
+    if (valid)
+    {
+        m_storage.resize(cell_count(m_header));
+        valid = fread(m_storage.data(), sizeof(uint16_t), m_storage.size(), file) == m_storage.size();
+    }
+    fclose(file);
+
+    if (!valid)
+    {
+        m_storage.clear();
+        return false;
+    }
+    m_cells = m_storage.data();
+#endif
+
+    if (!has_valid_actions(m_header, m_cells))
+    {
+        close();
+        return false;
+    }
+
+    uint32_t stride = 1;
+    for (int axis = 0; axis < AXIS_COUNT; axis++)
+    {
+        m_strides[axis] = stride;
+        stride *= m_header.counts[axis];
+    }
+    return true;
+}
+
+bool PolicyTable::write(const char *path, const Header &header, const uint16_t *cells)
+{
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr) return false;
+
+    bool written = fwrite(&header, sizeof(Header), 1, file) == 1 &&
+                   fwrite(cells, sizeof(uint16_t), cell_count(header), file) == cell_count(header);
+    return fclose(file) == 0 && written;
+}
+
+PolicyTable::Entry PolicyTable::lookup(const LanderState &state, float pad_x, float pad_y) const
+{
+    Entry entry;
+    if (m_cells == nullptr) return entry;
+
+    const float coordinates[AXIS_COUNT] = {
+        state.x - pad_x,
+        state.y - m_header.lander_half_height - pad_y,
+        state.velocity_x,
+        state.velocity_y,
+        state.angle
+    };
+
+    uint32_t index = 0;
+    for (int axis = 0; axis < AXIS_COUNT; axis++)
+    {
+        float cell = roundf((coordinates[axis] - m_header.minimum[axis]) / m_header.step[axis]);
+        int   last = (int) m_header.counts[axis] - 1;
+
+        // The offset axis and the ground are hard edges; everything else clamps
+        if ((axis == OFFSET_X && (cell < 0.0f || cell > (float) last)) || (axis == ALTITUDE && cell < 0.0f))
+        {
+            return entry;
+        }
+        index += (uint32_t) std::max(0, std::min(last, (int) cell)) * m_strides[axis];
+    }
+
+    uint16_t packed   = m_cells[index];
+    uint16_t fuel     = packed >> 4;
+    int      action   = packed & 0xF;
+
+    entry.landable = fuel != FUEL_UNLANDABLE;
+    entry.fuel     = entry.landable ? fuel * FUEL_QUANTUM : INFINITY;
+    entry.tilt     = tilt_for(m_header, action);
+    entry.thrust   = (action & 1) != 0;
+    return entry;
+}
+
+LanderInput PolicyTable::to_input(const Entry &entry, const LanderState &state)
+{
+    LanderState relative = state;
+    relative.angle = LanderPhysics::wrap_angle(state.angle - entry.tilt);
+
+    LanderInput input;
+    input.torque = LanderPhysics::levelling_torque(relative);
+    input.thrust = entry.thrust;
+    return input;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "LanderPhysics.h"
+
+// A precomputed landing policy: for every cell of a grid over the lander's
+// state relative to a pad, the input that lands it on the least fuel and how
+// much fuel that takes. tools/policy_solver.cpp computes it offline; the game
+// maps the file in and looks cells up in O(1).
+//
+// The state is (offset from the pad's middle, height of the feet above the
+// pad, velocity x, velocity y, angle). Fuel isn't an axis: the table already
+// says how much fuel a landing needs, so what's left in the tank only decides
+// whether it's enough. Angular velocity is taken as settled at each decision.
+//
+// An action is a tilt to hold (one of the angle axis values, tracked the way
+// W levels the lander) plus thrust on or off, kept for one decision step.
+//
+// File layout, native endian: Header, then one uint16_t per cell, offset
+// axis fastest. Low 4 bits: the action (tilt index * 2 + thrust). High 12
+// bits: fuel needed in FUEL_QUANTUM units, or FUEL_UNLANDABLE.
+class PolicyTable
+{
+public:
+    enum Axis { OFFSET_X, ALTITUDE, VELOCITY_X, VELOCITY_Y, ANGLE, AXIS_COUNT };
+
+    static constexpr char     MAGIC[8]        = { 'L', 'P', 'O', 'L', 'I', 'C', 'Y', '\0' };
+    static constexpr uint32_t VERSION         = 1;
+    static constexpr float    FUEL_QUANTUM    = 0.25f;
+    static constexpr uint16_t FUEL_UNLANDABLE = 0xFFF;
+    static constexpr int      MAX_ACTIONS     = 16;
+
+    struct Header
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t header_size;
+        uint32_t counts[AXIS_COUNT];
+        float    minimum[AXIS_COUNT];
+        float    step[AXIS_COUNT];
+
+        // What the table was solved for
+        float decision_seconds;
+        float pad_half_width;
+        float lander_half_height;
+        float max_touchdown_speed;
+    };
+
+    // One looked-up cell
+    struct Entry
+    {
+        bool  landable = false;
+        float fuel     = 0.0f;  // needed to land from here
+        float tilt     = 0.0f;  // radians to hold, clockwise from up
+        bool  thrust   = false;
+    };
+
+private:
+    Header m_header;
+    const uint16_t *m_cells = nullptr;
+    uint32_t m_strides[AXIS_COUNT];
+
+    void  *m_mapping      = nullptr;  // whole file, when memory mapped
+    size_t m_mapping_size = 0;
+    std::vector<uint16_t> m_storage;  // otherwise, a copy of the cells
+
+    void close();
+
+public:
+    PolicyTable() { }
+    ~PolicyTable() { close(); }
+
+    PolicyTable(const PolicyTable&) = delete;
+    PolicyTable& operator=(const PolicyTable&) = delete;
+
+    // Maps the file read-only (reads it in where there's no mmap). Returns
+    // false, leaving the table empty, if it's missing or malformed.
+    bool open(const char *path);
+    bool const is_open() const { return m_cells != nullptr; }
+
+    static bool write(const char *path, const Header &header, const uint16_t *cells);
+
+    // The cell nearest the lander's state relative to a pad whose top edge
+    // has its middle at (pad_x, pad_y). Off either side of the grid, or below
+    // the pad, comes back unlandable; too high or too fast clamps to the edge.
+    Entry lookup(const LanderState &state, float pad_x, float pad_y) const;
+
+    // The input that carries out an entry's action: torque towards its tilt
+    // (the same controller as W, around a different angle) and its thrust
+    static LanderInput to_input(const Entry &entry, const LanderState &state);
+
+    const Header& get_header() const { return m_header; }
+
+    // ————— PACKING ————— //
+    static uint32_t cell_count(const Header &header);
+    static uint16_t pack(int action, float fuel, bool landable);
+    static float    tilt_for(const Header &header, int action) { return header.minimum[ANGLE] + (action >> 1) * header.step[ANGLE]; }
+};
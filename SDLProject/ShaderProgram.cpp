@@ -2,6 +2,8 @@
 
 #include "ShaderProgram.h"
 
+ShaderProgram::FrameStats ShaderProgram::s_frame_stats;
+
 void ShaderProgram::load(const char *vertex_shader_file, const char *fragment_shader_file) {
     
     // create the vertex shader
@@ -13,6 +15,8 @@ void ShaderProgram::load(const char *vertex_shader_file, const char *fragment_sh
     m_program_id = glCreateProgram();
     glAttachShader(m_program_id, m_vertex_shader);
     glAttachShader(m_program_id, m_fragment_shader);
+    glBindAttribLocation(m_program_id, POSITION_ATTRIBUTE,  "position");
+    glBindAttribLocation(m_program_id, TEX_COORD_ATTRIBUTE, "texCoord");
     glLinkProgram(m_program_id);
     
     GLint link_success;
@@ -23,15 +27,22 @@ void ShaderProgram::load(const char *vertex_shader_file, const char *fragment_sh
         printf("Error linking shader program!\n");
     }
     
-    m_model_matrix_uniform      = glGetUniformLocation(m_program_id, "modelMatrix");
+    m_model_basis_uniform       = glGetUniformLocation(m_program_id, "modelBasis");
+    m_model_offset_uniform      = glGetUniformLocation(m_program_id, "modelOffset");
     m_projection_matrix_uniform = glGetUniformLocation(m_program_id, "projectionMatrix");
     m_view_matrix_uniform       = glGetUniformLocation(m_program_id, "viewMatrix");
     m_colour_uniform            = glGetUniformLocation(m_program_id, "color");
+    m_texture_rect_uniform      = glGetUniformLocation(m_program_id, "texRect");
     
     m_position_attribute  = glGetAttribLocation(m_program_id, "position");
     m_tex_coord_attribute = glGetAttribLocation(m_program_id, "texCoord");
     
+    // Fresh program, so nothing has been uploaded to it yet
+    m_model_transform_valid = m_view_matrix_valid = m_projection_matrix_valid = false;
+    m_colour_valid = m_texture_rect_valid = false;
+    
     set_colour(1.0f, 1.0f, 1.0f, 1.0f);
+    reset_texture_rect();
     
 }
 
@@ -88,26 +99,114 @@ GLuint ShaderProgram::load_shader_from_string(const std::string &shaderContents,
     return shaderID;
 }
 
+void ShaderProgram::use()
+{
+    if (GLState::use_program(m_program_id)) s_frame_stats.calls_issued++;
+    else                                     s_frame_stats.calls_elided++;
+}
+
+void ShaderProgram::upload_matrix(GLuint uniform, const glm::mat4 &matrix, glm::mat4 &shadow, bool &shadow_valid)
+{
+    if (shadow_valid && shadow == matrix)
+    {
+        s_frame_stats.calls_elided++;
+        return;
+    }
+
+    use();
+    glUniformMatrix4fv(uniform, 1, GL_FALSE, &matrix[0][0]);
+    s_frame_stats.calls_issued++;
+
+    shadow       = matrix;
+    shadow_valid = true;
+}
+
 void ShaderProgram::set_colour(float red, float green, float blue, float alpha)
 {
-    glUseProgram(m_program_id);
+    glm::vec4 colour(red, green, blue, alpha);
+
+    if (m_colour_valid && m_colour == colour)
+    {
+        s_frame_stats.calls_elided++;
+        return;
+    }
+
+    use();
     glUniform4f(m_colour_uniform, red, green, blue, alpha);
+    s_frame_stats.calls_issued++;
+
+    m_colour       = colour;
+    m_colour_valid = true;
+}
+
+void ShaderProgram::set_texture_rect(float u, float v, float width, float height)
+{
+    glm::vec4 texture_rect(u, v, width, height);
+
+    if (m_texture_rect_valid && m_texture_rect == texture_rect)
+    {
+        s_frame_stats.calls_elided++;
+        return;
+    }
+
+    use();
+    glUniform4f(m_texture_rect_uniform, u, v, width, height);
+    s_frame_stats.calls_issued++;
+
+    m_texture_rect       = texture_rect;
+    m_texture_rect_valid = true;
 }
 
 void ShaderProgram::set_view_matrix(const glm::mat4 &matrix)
 {
-    glUseProgram(m_program_id);
-    glUniformMatrix4fv(m_view_matrix_uniform, 1, GL_FALSE, &matrix[0][0]);
+    upload_matrix(m_view_matrix_uniform, matrix, m_view_matrix, m_view_matrix_valid);
 }
 
-void ShaderProgram::set_model_matrix(const glm::mat4 &matrix)
+void ShaderProgram::set_model_transform(const Transform2D &transform)
 {
-    glUseProgram(m_program_id);
-    glUniformMatrix4fv(m_model_matrix_uniform, 1, GL_FALSE, &matrix[0][0]);
+    const float *packed = transform.packed();
+
+    if (m_model_transform_valid)
+    {
+        bool basis_same  = true, offset_same = true;
+        for (int i = 0; i < 4; i++) basis_same  = basis_same  && packed[i] == m_model_transform[i];
+        for (int i = 4; i < 6; i++) offset_same = offset_same && packed[i] == m_model_transform[i];
+
+        if (basis_same && offset_same)
+        {
+            s_frame_stats.calls_elided += 2;
+            return;
+        }
+
+        // Sprites mostly move without turning, so the basis usually survives
+        use();
+        if (basis_same) s_frame_stats.calls_elided++;
+        else
+        {
+            glUniform4fv(m_model_basis_uniform, 1, packed);
+            s_frame_stats.calls_issued++;
+        }
+
+        if (offset_same) s_frame_stats.calls_elided++;
+        else
+        {
+            glUniform2fv(m_model_offset_uniform, 1, packed + 4);
+            s_frame_stats.calls_issued++;
+        }
+    }
+    else
+    {
+        use();
+        glUniform4fv(m_model_basis_uniform, 1, packed);
+        glUniform2fv(m_model_offset_uniform, 1, packed + 4);
+        s_frame_stats.calls_issued += 2;
+    }
+
+    for (int i = 0; i < Transform2D::PACKED_FLOATS; i++) m_model_transform[i] = packed[i];
+    m_model_transform_valid = true;
 }
 
 void ShaderProgram::set_projection_matrix(const glm::mat4 &matrix)
 {
-    glUseProgram(m_program_id);
-    glUniformMatrix4fv(m_projection_matrix_uniform, 1, GL_FALSE, &matrix[0][0]);
+    upload_matrix(m_projection_matrix_uniform, matrix, m_projection_matrix, m_projection_matrix_valid);
 }
@@ -10,11 +10,28 @@
 #include <fstream>
 #include <sstream>
 #include "glm/mat4x4.hpp"
+#include "glm/vec4.hpp"
+#include "GLState.h"
+#include "Transform2D.h"
 
 class ShaderProgram
 {
+public:
+    // Every program binds its vertex inputs to these slots before linking, so
+    // a mesh's attribute layout works with any of them
+    static constexpr GLuint POSITION_ATTRIBUTE  = 0;
+    static constexpr GLuint TEX_COORD_ATTRIBUTE = 1;
+
+    // GL calls made through this class since the last begin_frame()
+    struct FrameStats
+    {
+        int calls_issued = 0;
+        int calls_elided = 0;
+    };
+
 private:
     void cleanup();
+    void upload_matrix(GLuint uniform, const glm::mat4 &matrix, glm::mat4 &shadow, bool &shadow_valid);
     
     GLuint load_shader_from_string(const std::string &shader_contents, GLenum shader_type);
     GLuint load_shader_from_file(const std::string &shader_file, GLenum shader_type);
@@ -22,28 +39,62 @@ private:
     GLuint m_program_id;
 
     GLuint m_projection_matrix_uniform;
-    GLuint m_model_matrix_uniform;
+    GLuint m_model_basis_uniform;
+    GLuint m_model_offset_uniform;
     GLuint m_view_matrix_uniform;
     GLuint m_colour_uniform;
+    GLuint m_texture_rect_uniform;
 
     GLuint m_position_attribute;
     GLuint m_tex_coord_attribute;
 
     GLuint m_vertex_shader;
     GLuint m_fragment_shader;
+
+    // ————— UNIFORM SHADOWS ————— //
+    // Last values uploaded to this program; GL keeps uniforms per program, so
+    // these stay valid across switches to other programs
+    float     m_model_transform[Transform2D::PACKED_FLOATS];
+    glm::mat4 m_view_matrix, m_projection_matrix;
+    glm::vec4 m_colour, m_texture_rect;
+    bool m_model_transform_valid   = false,
+         m_view_matrix_valid       = false,
+         m_projection_matrix_valid = false,
+         m_colour_valid            = false,
+         m_texture_rect_valid      = false;
+
+    static FrameStats s_frame_stats;
     
 public:
 
     void load(const char *vertex_shader_file, const char *fragment_shader_file);
 
-    void set_model_matrix(const glm::mat4 &matrix);
+    void set_model_transform(const Transform2D &transform);
     void set_projection_matrix(const glm::mat4 &matrix);
     void set_view_matrix(const glm::mat4 &matrix);
     void set_colour(float red, float green, float blue, float alpha);
+
+    // Sub-rectangle of the bound texture that a mesh's 0..1 UVs map onto,
+    // as (u, v, width, height); used to pick a frame out of an atlas
+    void set_texture_rect(float u, float v, float width, float height);
+    void reset_texture_rect() { set_texture_rect(0.0f, 0.0f, 1.0f, 1.0f); }
+
+    // Binds this program unless it is already the current one
+    void use();
+    
+    static void begin_frame() { s_frame_stats = FrameStats(); }
+    static FrameStats const get_frame_stats() { return s_frame_stats; }
     
     GLuint const get_program_id()               const { return m_program_id;          };
     GLuint const get_position_attribute()       const { return m_position_attribute;  };
     GLuint const get_tex_coordinate_attribute() const { return m_tex_coord_attribute; };
     
-    void set_program_id(GLuint program_id)                         { m_program_id = program_id;                   };
+    void set_program_id(GLuint program_id)
+    {
+        m_program_id = program_id;
+
+        // A different program has its own uniform values
+        m_model_transform_valid = m_view_matrix_valid = m_projection_matrix_valid = false;
+        m_colour_valid = m_texture_rect_valid = false;
+    };
 };
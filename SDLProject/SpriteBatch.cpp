@@ -0,0 +1,92 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "SpriteBatch.h"
+#include <cstddef>
+#include "Mesh.h"
+
+SpriteBatch::SpriteBatch(int capacity) : m_capacity(capacity)
+{
+    // The only allocation this batch ever makes
+    m_instances.resize(capacity);
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    if (m_instance_buffer != 0) GLState::delete_buffer(m_instance_buffer);
+#ifndef USE_LEGACY_GL
+    if (m_vertex_array != 0) GLState::delete_vertex_array(m_vertex_array);
+#endif
+}
+
+void SpriteBatch::create()
+{
+#ifndef USE_LEGACY_GL
+    // Fetch first: creating the shared quad binds its own VAO
+    GLuint quad_buffer = Mesh::unit_quad()->get_buffer_id();
+
+    glGenBuffers(1, &m_instance_buffer);
+    glGenVertexArrays(1, &m_vertex_array);
+    GLState::bind_vertex_array(m_vertex_array);
+
+    // Per-vertex quad, shared with every other sprite
+    GLState::bind_array_buffer(quad_buffer);
+    Mesh::describe_attributes();
+    glEnableVertexAttribArray(ShaderProgram::POSITION_ATTRIBUTE);
+    glEnableVertexAttribArray(ShaderProgram::TEX_COORD_ATTRIBUTE);
+
+    // Per-instance records, advanced once per sprite instead of once per vertex
+    GLState::bind_array_buffer(m_instance_buffer);
+    glBufferData(GL_ARRAY_BUFFER, m_capacity * sizeof(Instance), nullptr, GL_STREAM_DRAW);
+
+    const GLsizei stride = sizeof(Instance);
+    glVertexAttribPointer(OFFSET_ATTRIBUTE, 2, GL_FLOAT, false, stride,
+                          (const void*) offsetof(Instance, x));
+    glVertexAttribPointer(ROTATION_ATTRIBUTE, 1, GL_FLOAT, false, stride,
+                          (const void*) offsetof(Instance, rotation));
+    glVertexAttribPointer(SCALE_ATTRIBUTE, 2, GL_FLOAT, false, stride,
+                          (const void*) offsetof(Instance, scale_x));
+    glVertexAttribPointer(TEXTURE_RECT_ATTRIBUTE, 4, GL_FLOAT, false, stride,
+                          (const void*) offsetof(Instance, u));
+    glVertexAttribPointer(COLOUR_ATTRIBUTE, 4, GL_FLOAT, false, stride,
+                          (const void*) offsetof(Instance, red));
+
+    const GLuint instance_attributes[] = { OFFSET_ATTRIBUTE, ROTATION_ATTRIBUTE,
+                                           SCALE_ATTRIBUTE, TEXTURE_RECT_ATTRIBUTE, COLOUR_ATTRIBUTE };
+    for (GLuint attribute : instance_attributes)
+    {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+
+    GLState::bind_vertex_array(0);
+#endif
+}
+
+void SpriteBatch::render(ShaderProgram *program, GLuint texture_id)
+{
+    if (m_count == 0) return;
+
+    program->use();
+    GLState::bind_texture(texture_id);
+
+#ifdef USE_LEGACY_GL
+    for (int i = 0; i < m_count; i++)
+    {
+        const Instance &instance = m_instances[i];
+        program->set_model_transform(Transform2D(instance.x, instance.y, instance.rotation,
+                                                 instance.scale_x, instance.scale_y));
+        program->set_texture_rect(instance.u, instance.v, instance.width, instance.height);
+        Mesh::unit_quad()->draw();
+    }
+#else
+    if (m_vertex_array == 0) create();
+
+    // Orphan last frame's storage so the driver needn't wait on draws still reading it
+    GLState::bind_array_buffer(m_instance_buffer);
+    glBufferData(GL_ARRAY_BUFFER, m_capacity * sizeof(Instance), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, m_count * sizeof(Instance), m_instances.data());
+
+    GLState::bind_vertex_array(m_vertex_array);
+    GLState::draw_arrays_instanced(GL_TRIANGLES, 0, 6, m_count);
+#endif
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <vector>
+#include "GLState.h"
+#include "ShaderProgram.h"
+
+// Draws many copies of one texture with a single instanced call: every sprite
+// shares the unit quad and only its per-instance record is uploaded. Built
+// with USE_LEGACY_GL there's no instancing, so the batch falls back to one
+// draw per sprite through the regular textured program (which also ignores
+// the tint).
+class SpriteBatch
+{
+public:
+    struct Instance
+    {
+        float x, y;
+        float rotation;  // radians, counter-clockwise
+        float scale_x, scale_y;
+        float u, v, width, height;  // atlas rect
+        float red, green, blue, alpha;  // multiplied into the texture
+    };
+
+    // Attribute slots for the per-instance data, after position and texCoord
+    static constexpr GLuint OFFSET_ATTRIBUTE       = 2;
+    static constexpr GLuint ROTATION_ATTRIBUTE     = 3;
+    static constexpr GLuint SCALE_ATTRIBUTE        = 4;
+    static constexpr GLuint TEXTURE_RECT_ATTRIBUTE = 5;
+    static constexpr GLuint COLOUR_ATTRIBUTE       = 6;
+
+private:
+    std::vector<Instance> m_instances;  // sized to capacity up front
+    int m_capacity;
+    int m_count = 0;
+
+    GLuint m_vertex_array    = 0;
+    GLuint m_instance_buffer = 0;
+
+    void create();
+
+public:
+    // ————— CONSTRUCTORS ————— //
+    explicit SpriteBatch(int capacity);
+    ~SpriteBatch();
+
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+    // ————— METHODS ————— //
+    void clear() { m_count = 0; }
+
+    // Returns false once the batch is full; storage never grows past capacity
+    bool add(const Instance &instance)
+    {
+        if (m_count >= m_capacity) return false;
+        m_instances[m_count++] = instance;
+        return true;
+    }
+
+    // Claims up to `count` records to be filled in place, for callers that
+    // convert their own storage in bulk. Returns the first one and how many
+    // were actually claimed (fewer once the batch is nearly full).
+    Instance* append(int count, int *claimed)
+    {
+        *claimed = count < m_capacity - m_count ? count : m_capacity - m_count;
+        Instance *first = m_instances.data() + m_count;
+        m_count += *claimed;
+        return first;
+    }
+
+    // `program` is the instanced shader, or the regular textured one with USE_LEGACY_GL
+    void render(ShaderProgram *program, GLuint texture_id);
+
+    int const get_count()    const { return m_count; }
+    int const get_capacity() const { return m_capacity; }
+};
@@ -0,0 +1,481 @@
+#define GL_SILENCE_DEPRECATION
+
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL.h>
+#include <SDL_opengl.h>
+#include <math.h>
+#include <algorithm>
+#include "glm/glm.hpp"
+#include "Systems.h"
+#include "Autopilot.h"
+#include "Map.h"
+#include "GLState.h"
+#include "Mesh.h"
+
+// ————— PILOT ————— //
+void Systems::pilot(World &world, float delta_time)
+{
+    ComponentPool<AI> &ai_pool = world.pool<AI>();
+
+    for (size_t position = 0; position < ai_pool.size(); position++)
+    {
+        AI &ai = ai_pool.data()[position];
+        if (ai.autopilot == nullptr) continue;
+
+        if (ai.engaged) ai.input = ai.autopilot->update(lander_state(world, ai_pool.owner(position)), delta_time);
+        else            ai.autopilot->reset();
+    }
+}
+
+// ————— MOVE ————— //
+void Systems::move(World &world, float delta_time, size_t first, size_t last)
+{
+    ComponentPool<Velocity>  &velocities = world.pool<Velocity>();
+    ComponentPool<Transform> &transforms = world.pool<Transform>();
+    ComponentPool<Collider>  &colliders  = world.pool<Collider>();
+    ComponentPool<Fuel>      &fuel_pool  = world.pool<Fuel>();
+    ComponentPool<AI>        &ai_pool    = world.pool<AI>();
+
+    last = std::min(last, velocities.size());
+    for (size_t position = first; position < last; position++)
+    {
+        EntityId entity = velocities.owner(position);
+
+        Collider *collider = colliders.find(entity, position);
+        if (collider != nullptr && collider->finished) continue;
+
+        Velocity  &velocity  = velocities.data()[position];
+        Transform *transform = transforms.find(entity, position);
+        Fuel      *fuel      = fuel_pool.find(entity, position);
+        AI        *ai        = ai_pool.find(entity, position);
+        if (transform == nullptr) continue;
+
+        LanderInput input;
+        if (ai != nullptr) input = ai->input;
+
+        // Thrust only fires while there's fuel; integrate burns it
+        input.thrust = input.thrust && fuel != nullptr && fuel->amount > 0.0f;
+
+        LanderState state;
+        state.x                = transform->x;
+        state.y                = transform->y;
+        state.velocity_x       = velocity.x;
+        state.velocity_y       = velocity.y;
+        state.angle            = transform->angle;
+        state.angular_velocity = velocity.angular;
+        state.fuel             = fuel != nullptr ? fuel->amount : 0.0f;
+
+        LanderPhysics::integrate(state, input, delta_time);
+
+        transform->x     = state.x;
+        transform->y     = state.y;
+        transform->angle = state.angle;
+        velocity.x       = state.velocity_x;
+        velocity.y       = state.velocity_y;
+        velocity.angular = state.angular_velocity;
+        if (fuel != nullptr)
+        {
+            fuel->amount  = state.fuel;
+            fuel->burning = input.thrust;
+        }
+    }
+}
+
+// ————— COLLIDE ————— //
+static bool overlaps(const Transform &transform, const Collider &collider, const Transform &other, const Collider &other_collider)
+{
+    float x_distance = fabs(transform.x - other.x) - ((collider.width + other_collider.width) / 2.0f);
+    float y_distance = fabs(transform.y - other.y) - ((collider.height + other_collider.height) / 2.0f);
+
+    return x_distance < 0.0f && y_distance < 0.0f;
+}
+
+// Anything with a Collider and no Velocity stays put for movers to stop
+// against. Statics made with the same components in the same order as each
+// other line their Transforms up with their Colliders, so the hint lands.
+template <bool VERTICAL>
+static void collide_statics(World &world, EntityId entity, Transform &transform, Velocity &velocity, Collider &collider)
+{
+    ComponentPool<Collider>  &colliders  = world.pool<Collider>();
+    ComponentPool<Transform> &transforms = world.pool<Transform>();
+
+    for (size_t position = 0; position < colliders.size(); position++)
+    {
+        EntityId other = colliders.owner(position);
+        const Collider  &other_collider  = colliders.data()[position];
+        const Transform *other_transform = transforms.find(other, position);
+
+        if (other_transform == nullptr || !overlaps(transform, collider, *other_transform, other_collider)) continue;
+        if (other == entity || world.has<Velocity>(other)) continue;
+
+        if (VERTICAL)
+        {
+            float y_distance = fabs(transform.y - other_transform->y);
+            float y_overlap  = fabs(y_distance - (collider.height / 2.0f) - (other_collider.height / 2.0f));
+            if (velocity.y > 0)
+            {
+                transform.y -= y_overlap;
+                velocity.y   = 0;
+                collider.top = true;
+            }
+            else if (velocity.y < 0)
+            {
+                transform.y    += y_overlap;
+                velocity.y      = 0;
+                collider.bottom = true;
+            }
+        }
+        else
+        {
+            float x_distance = fabs(transform.x - other_transform->x);
+            float x_overlap  = fabs(x_distance - (collider.width / 2.0f) - (other_collider.width / 2.0f));
+            if (velocity.x > 0)
+            {
+                transform.x   -= x_overlap;
+                velocity.x     = 0;
+                collider.right = true;
+            }
+            else if (velocity.x < 0)
+            {
+                transform.x  += x_overlap;
+                velocity.x    = 0;
+                collider.left = true;
+            }
+        }
+    }
+}
+
+// Whether any Collider belongs to something without a Velocity. Movers made
+// first sit at the same positions in both pools, so mostly this is just a
+// walk comparing owners.
+static bool has_statics(const World &world)
+{
+    const ComponentPool<Collider> &colliders  = world.pool<Collider>();
+    const ComponentPool<Velocity> &velocities = world.pool<Velocity>();
+
+    for (size_t position = 0; position < colliders.size(); position++)
+    {
+        EntityId owner = colliders.owner(position);
+        bool moving = position < velocities.size() && velocities.owner(position) == owner;
+        if (!moving && !velocities.has(owner)) return true;
+    }
+    return false;
+}
+
+// Any tile at all ends the flight; the pad (tile 3) is the one that counts
+// as a landing
+static void touch_tile(Collider &collider, int tile_type)
+{
+    if (tile_type <= 0) return;
+
+    collider.finished     = true;
+    collider.touched_tile = tile_type;
+}
+
+// Movers are collided a block at a time, and the map probes of the whole
+// block (two per mover: left/right, then top/bottom) go through one
+// is_solid_batch call, so the SIMD path gets full lanes. Sized so the
+// scratch fits on the stack.
+static const size_t COLLIDE_BLOCK = 64;
+
+struct Mover
+{
+    EntityId   entity;
+    Transform *transform;
+    Velocity  *velocity;
+    Collider  *collider;
+    bool       probed;  // has probes in the current batch
+};
+
+// Where a block's probes go and their answers come back
+struct MapProbes
+{
+    float xs[COLLIDE_BLOCK * 2], ys[COLLIDE_BLOCK * 2];
+    int   tile_types[COLLIDE_BLOCK * 2];
+    float penetration_x[COLLIDE_BLOCK * 2], penetration_y[COLLIDE_BLOCK * 2];
+    int   count = 0;
+
+    void add(float x, float y)
+    {
+        xs[count] = x;
+        ys[count] = y;
+        count++;
+    }
+
+    void run(const Map *map)
+    {
+        if (count == 0) return;
+
+        Map::ProbeResults results;
+        results.tile_types    = tile_types;
+        results.penetration_x = penetration_x;
+        results.penetration_y = penetration_y;
+        map->is_solid_batch(xs, ys, count, results);
+    }
+};
+
+// `probe` is where the mover's left and right probes sit in the batch
+static void collide_map_x(const MapProbes &probes, int probe, Transform &transform, Velocity &velocity, Collider &collider)
+{
+    const int LEFT = probe, RIGHT = probe + 1;
+    const int   *tile_types    = probes.tile_types;
+    const float *penetration_x = probes.penetration_x;
+
+    int tile_type = -1;
+
+    if (tile_types[LEFT] > 0 && velocity.x < 0)
+    {
+        transform.x  += penetration_x[LEFT];
+        velocity.x    = 0;
+        collider.left = true;
+        tile_type     = tile_types[LEFT];
+    }
+
+    if (tile_types[RIGHT] > 0 && velocity.x > 0)
+    {
+        transform.x   -= penetration_x[RIGHT];
+        velocity.x     = 0;
+        collider.right = true;
+        tile_type      = tile_types[RIGHT];
+    }
+
+    touch_tile(collider, tile_type);
+}
+
+// Likewise with the top and bottom probes
+static void collide_map_y(const MapProbes &probes, int probe, Transform &transform, Velocity &velocity, Collider &collider)
+{
+    const int TOP = probe, BOTTOM = probe + 1;
+    const int   *tile_types    = probes.tile_types;
+    const float *penetration_y = probes.penetration_y;
+
+    int tile_type = -1;
+
+    if (tile_types[BOTTOM] > 0 && velocity.y < 0)
+    {
+        transform.y    += penetration_y[BOTTOM];
+        velocity.y      = 0;
+        collider.bottom = true;
+        tile_type       = tile_types[BOTTOM];
+    }
+
+    if (tile_types[TOP] > 0 && velocity.y > 0)
+    {
+        transform.y  -= penetration_y[TOP];
+        velocity.y    = 0;
+        collider.top  = true;
+        tile_type     = tile_types[TOP];
+    }
+
+    touch_tile(collider, tile_type);
+}
+
+static bool region_empty(const Map *map, const Transform &transform, const Collider &collider)
+{
+    glm::vec3 centre      = glm::vec3(transform.x, transform.y, 0.0f);
+    glm::vec3 half_extent = glm::vec3(collider.width / 2, collider.height / 2, 0.0f);
+    return map->is_region_empty(centre - half_extent, centre + half_extent);
+}
+
+// Each mover still goes statics x, map x, statics y, map y, just with every
+// mover's x done before anyone's y. Movers only collide with statics and the
+// map, never each other, so that comes out the same.
+static void collide_block(World &world, const Map *map, bool statics, Mover *movers, size_t count)
+{
+    MapProbes probes;
+
+    // ————— X ————— //
+    for (size_t i = 0; i < count; i++)
+    {
+        Mover &mover = movers[i];
+        Transform &transform = *mover.transform;
+        Collider  &collider  = *mover.collider;
+
+        collider.top = collider.bottom = collider.left = collider.right = false;
+        if (statics) collide_statics<false>(world, mover.entity, transform, *mover.velocity, collider);
+
+        // Out in open sky the map probes can't hit anything, so skip them
+        mover.probed = map != nullptr && !region_empty(map, transform, collider);
+        if (!mover.probed) continue;
+
+        probes.add(transform.x - (collider.width / 2), transform.y);
+        probes.add(transform.x + (collider.width / 2), transform.y);
+    }
+
+    probes.run(map);
+    int probe = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!movers[i].probed) continue;
+        collide_map_x(probes, probe, *movers[i].transform, *movers[i].velocity, *movers[i].collider);
+        probe += 2;
+    }
+
+    // ————— Y ————— //
+    probes.count = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        Mover &mover = movers[i];
+        Transform &transform = *mover.transform;
+        Collider  &collider  = *mover.collider;
+
+        if (statics) collide_statics<true>(world, mover.entity, transform, *mover.velocity, collider);
+
+        mover.probed = map != nullptr && !region_empty(map, transform, collider);
+        if (!mover.probed) continue;
+
+        probes.add(transform.x, transform.y + (collider.height / 2));
+        probes.add(transform.x, transform.y - (collider.height / 2));
+    }
+
+    probes.run(map);
+    probe = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        Collider &collider = *movers[i].collider;
+        if (movers[i].probed)
+        {
+            collide_map_y(probes, probe, *movers[i].transform, *movers[i].velocity, collider);
+            probe += 2;
+        }
+
+        // Touching anything from above or below ends the flight
+        if (collider.top || collider.bottom) collider.finished = true;
+    }
+}
+
+void Systems::collide(World &world, const Map *map, size_t first, size_t last)
+{
+    ComponentPool<Velocity>  &velocities = world.pool<Velocity>();
+    ComponentPool<Transform> &transforms = world.pool<Transform>();
+    ComponentPool<Collider>  &colliders  = world.pool<Collider>();
+
+    bool statics = has_statics(world);
+
+    Mover  movers[COLLIDE_BLOCK];
+    size_t count = 0;
+
+    last = std::min(last, velocities.size());
+    for (size_t position = first; position < last; position++)
+    {
+        EntityId entity = velocities.owner(position);
+
+        Collider *collider = colliders.find(entity, position);
+        if (collider == nullptr || collider->finished) continue;
+
+        Transform *transform = transforms.find(entity, position);
+        if (transform == nullptr) continue;
+
+        movers[count++] = { entity, transform, &velocities.data()[position], collider, false };
+        if (count == COLLIDE_BLOCK)
+        {
+            collide_block(world, map, statics, movers, count);
+            count = 0;
+        }
+    }
+
+    if (count > 0) collide_block(world, map, statics, movers, count);
+}
+
+// ————— ANIMATE ————— //
+void Systems::animate(World &world)
+{
+    ComponentPool<Sprite> &sprites   = world.pool<Sprite>();
+    ComponentPool<Fuel>   &fuel_pool = world.pool<Fuel>();
+
+    for (size_t position = 0; position < sprites.size(); position++)
+    {
+        const Fuel *fuel = fuel_pool.find(sprites.owner(position), position);
+        sprites.data()[position].animation = fuel != nullptr && fuel->burning ? ATTACK : IDLE;
+    }
+}
+
+void Systems::step(World &world, const Map *map, float delta_time)
+{
+    size_t movers = world.pool<Velocity>().size();
+
+    pilot(world, delta_time);
+    move(world, delta_time, 0, movers);
+    collide(world, map, 0, movers);
+    animate(world);
+}
+
+// ————— FLIGHT STATE ————— //
+LanderState Systems::lander_state(const World &world, EntityId entity)
+{
+    LanderState state;
+    if (const Transform *transform = world.get<Transform>(entity))
+    {
+        state.x     = transform->x;
+        state.y     = transform->y;
+        state.angle = transform->angle;
+    }
+    if (const Velocity *velocity = world.get<Velocity>(entity))
+    {
+        state.velocity_x       = velocity->x;
+        state.velocity_y       = velocity->y;
+        state.angular_velocity = velocity->angular;
+    }
+    if (const Fuel *fuel = world.get<Fuel>(entity)) state.fuel = fuel->amount;
+    return state;
+}
+
+void Systems::set_lander_state(World &world, EntityId entity, const LanderState &state)
+{
+    if (Transform *transform = world.get<Transform>(entity))
+    {
+        transform->x     = state.x;
+        transform->y     = state.y;
+        transform->angle = state.angle;
+    }
+    if (Velocity *velocity = world.get<Velocity>(entity))
+    {
+        velocity->x       = state.velocity_x;
+        velocity->y       = state.velocity_y;
+        velocity->angular = state.angular_velocity;
+    }
+    if (Fuel *fuel = world.get<Fuel>(entity)) fuel->amount = state.fuel;
+}
+
+// ————— DRAWING ————— //
+Sprite::RenderState Systems::render_state(const World &world, EntityId entity)
+{
+    Sprite::RenderState state;
+
+    const Transform *transform = world.get<Transform>(entity);
+    const Sprite    *sprite    = world.get<Sprite>(entity);
+    if (transform == nullptr || sprite == nullptr) return state;
+
+    state.x        = transform->x;
+    state.y        = transform->y;
+    state.rotation = glm::degrees(transform->angle);
+    state.scale_x  = sprite->scale_x;
+    state.scale_y  = sprite->scale_y;
+
+    // Pick the current frame out of the animation's texture atlas
+    state.texture_id = sprite->texture_ids[sprite->animation];
+    state.u      = (float) (sprite->frame % sprite->columns) / (float) sprite->columns;
+    state.v      = (float) (sprite->frame / sprite->columns) / (float) sprite->rows;
+    state.width  = 1.0f / (float) sprite->columns;
+    state.height = 1.0f / (float) sprite->rows;
+
+    return state;
+}
+
+void Systems::draw(ShaderProgram *program, const Sprite::RenderState &state, Transform2D &transform)
+{
+    // rotation is clockwise degrees; the transform wants counter-clockwise radians
+    transform.set_position(state.x, state.y);
+    transform.set_rotation(-glm::radians(state.rotation));
+    transform.set_scale(state.scale_x, state.scale_y);
+    program->set_model_transform(transform);
+
+    program->set_texture_rect(state.u, state.v, state.width, state.height);
+    GLState::bind_texture(state.texture_id);
+
+    Mesh::unit_quad()->draw();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stddef.h>
+#include "World.h"
+#include "LanderPhysics.h"
+#include "ShaderProgram.h"
+
+class Map;
+
+// The game's behaviour, as passes over World's packed arrays.
+// Everything that moves has a Velocity; the passes walk the Velocity pool in
+// order and pick up each mover's other components by position, so a step
+// reads memory front to back instead of chasing one fat object per entity.
+//
+// The ranged passes take [first, last) positions in the Velocity pool, so
+// callers can split a big world across threads. Movers whose Collider has
+// finished are left alone.
+namespace Systems
+{
+    // Hands engaged autopilots the controls (writing AI::input); disengaged
+    // ones forget their target so they pick a pad afresh next time
+    void pilot(World &world, float delta_time);
+
+    // Flies each mover one step on its AI's input (or none), burning Fuel
+    void move(World &world, float delta_time, size_t first, size_t last);
+
+    // Stops movers against static colliders and the map, and finishes them
+    // on anything they land on or hit from above or below
+    void collide(World &world, const Map *map, size_t first, size_t last);
+
+    // Sprites show the ATTACK sheet while their engine's burning
+    void animate(World &world);
+
+    // All of the above over the whole world, in order
+    void step(World &world, const Map *map, float delta_time);
+
+    // Flight state from an entity's Transform, Velocity and Fuel
+    LanderState lander_state(const World &world, EntityId entity);
+    void set_lander_state(World &world, EntityId entity, const LanderState &state);
+
+    Sprite::RenderState render_state(const World &world, EntityId entity);
+
+    // `transform` is the caller's, kept between draws so its basis only gets
+    // recomputed when the rotation or scale changed
+    void draw(ShaderProgram *program, const Sprite::RenderState &state, Transform2D &transform);
+}
@@ -0,0 +1,123 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "TextLabel.h"
+#include "GLState.h"
+
+TextLabel::TextLabel(GLuint font_texture_id, float font_size, float spacing, glm::vec3 position)
+    : m_font_texture_id(font_texture_id), m_font_size(font_size), m_spacing(spacing),
+      m_transform(position.x, position.y),
+      m_mesh(GL_DYNAMIC_DRAW)
+{
+    m_text[0] = '\0';
+}
+
+TextLabel::~TextLabel() { }
+
+void TextLabel::tessellate(const char *text, int length, float font_size, float spacing, float *out)
+{
+    // Scale the size of the fontbank in the UV-plane
+    float width  = 1.0f / FONTBANK_SIZE;
+    float height = 1.0f / FONTBANK_SIZE;
+
+    float half = 0.5f * font_size;
+
+    for (int i = 0; i < length; i++)
+    {
+        int spritesheet_index = (unsigned char) text[i];  // ascii value of character
+        float offset = (font_size + spacing) * i;
+
+        float u = (float) (spritesheet_index % FONTBANK_SIZE) / FONTBANK_SIZE;
+        float v = (float) (spritesheet_index / FONTBANK_SIZE) / FONTBANK_SIZE;
+
+        float glyph[FLOATS_PER_GLYPH] =
+        {
+            offset - half,  half, u,         v,
+            offset - half, -half, u,         v + height,
+            offset + half,  half, u + width, v,
+            offset + half, -half, u + width, v + height,
+            offset + half,  half, u + width, v,
+            offset - half, -half, u,         v + height,
+        };
+
+        for (int j = 0; j < FLOATS_PER_GLYPH; j++) out[i * FLOATS_PER_GLYPH + j] = glyph[j];
+    }
+}
+
+int TextLabel::format_int(int value, char *out)
+{
+    char digits[12];
+    int count = 0;
+
+    // Work in unsigned so INT_MIN doesn't overflow on negation
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int) value : (unsigned int) value;
+
+    do
+    {
+        digits[count++] = (char) ('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    int length = 0;
+    if (value < 0) out[length++] = '-';
+    while (count > 0) out[length++] = digits[--count];
+
+    return length;
+}
+
+void TextLabel::set_text(const char *text)
+{
+    int i = 0;
+    while (i < MAX_CHARACTERS && text[i] != '\0' && text[i] == m_text[i]) i++;
+
+    // Same string as last time; keep the uploaded geometry
+    if (i == m_length && (i == MAX_CHARACTERS || text[i] == '\0')) return;
+
+    while (i < MAX_CHARACTERS && text[i] != '\0')
+    {
+        m_text[i] = text[i];
+        i++;
+    }
+
+    m_text[i] = '\0';
+    m_length  = i;
+    m_dirty   = true;
+}
+
+void TextLabel::set_value(const char *prefix, int value, const char *suffix)
+{
+    // Longest int is 11 characters, so this always fits before truncation below
+    char buffer[MAX_CHARACTERS + 12];
+    int length = 0;
+
+    while (*prefix != '\0' && length < MAX_CHARACTERS) buffer[length++] = *prefix++;
+    length += format_int(value, buffer + length);
+    while (*suffix != '\0' && length < MAX_CHARACTERS) buffer[length++] = *suffix++;
+
+    if (length > MAX_CHARACTERS) length = MAX_CHARACTERS;
+    buffer[length] = '\0';
+
+    set_text(buffer);
+}
+
+void TextLabel::upload()
+{
+    tessellate(m_text, m_length, m_font_size, m_spacing, m_vertex_data);
+
+    // Size the buffer for the longest string up front so later edits never reallocate
+    if (m_mesh.get_vertex_capacity() == 0) m_mesh.reserve(MAX_CHARACTERS * VERTICES_PER_GLYPH);
+    m_mesh.update(m_vertex_data, m_length * VERTICES_PER_GLYPH);
+
+    m_dirty = false;
+}
+
+void TextLabel::render(ShaderProgram *program)
+{
+    if (m_length == 0) return;
+    if (m_dirty) upload();
+
+    program->set_model_transform(m_transform);
+    program->reset_texture_rect();
+
+    GLState::bind_texture(m_font_texture_id);
+    m_mesh.draw();
+}
@@ -0,0 +1,65 @@
+#pragma once
+#define GL_SILENCE_DEPRECATION
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL.h>
+#include <SDL_opengl.h>
+#include "glm/mat4x4.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "ShaderProgram.h"
+#include "Mesh.h"
+
+// A retained-mode line of HUD text. The glyph quads live in a mesh
+// that is only rebuilt when the displayed string actually changes, so a
+// readout that is re-set every frame costs a short string compare and nothing else.
+class TextLabel
+{
+public:
+    static constexpr int MAX_CHARACTERS     = 32;
+    static constexpr int FONTBANK_SIZE      = 16;
+    static constexpr int FLOATS_PER_VERTEX  = Mesh::FLOATS_PER_VERTEX;  // x, y, u, v
+    static constexpr int VERTICES_PER_GLYPH = 6;
+    static constexpr int FLOATS_PER_GLYPH   = FLOATS_PER_VERTEX * VERTICES_PER_GLYPH;
+
+private:
+    GLuint m_font_texture_id;
+    float m_font_size, m_spacing;
+    Transform2D m_transform;
+
+    // ————— TEXT ————— //
+    char m_text[MAX_CHARACTERS + 1];
+    int  m_length = 0;
+    bool m_dirty  = true;
+
+    // ————— GEOMETRY ————— //
+    float m_vertex_data[MAX_CHARACTERS * FLOATS_PER_GLYPH];
+    Mesh  m_mesh;
+
+    void upload();
+
+public:
+    // ————— CONSTRUCTORS ————— //
+    TextLabel(GLuint font_texture_id, float font_size, float spacing, glm::vec3 position);
+    ~TextLabel();
+
+    TextLabel(const TextLabel&) = delete;
+    TextLabel& operator=(const TextLabel&) = delete;
+
+    // ————— METHODS ————— //
+    void set_text(const char *text);
+    void set_value(const char *prefix, int value, const char *suffix);
+    void render(ShaderProgram *program);
+
+    const char* get_text() const { return m_text;   }
+    int   const get_length() const { return m_length; }
+
+    // Writes interleaved (x, y, u, v) triangles for `length` glyphs into `out`,
+    // which must hold at least length * FLOATS_PER_GLYPH floats.
+    static void tessellate(const char *text, int length, float font_size, float spacing, float *out);
+
+    // Writes the decimal digits of `value` into `out` without touching the heap.
+    // Returns the number of characters written (no terminator).
+    static int format_int(int value, char *out);
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "FastTrig.h"
+
+// Position, rotation and scale of a sprite in the plane. The rotation/scale
+// part is only turned into a 2x2 basis when it's read after a change, so
+// moving an object every physics step never touches sin/cos (and a spinning
+// one only pays for fast_sincos).
+//
+// Uploaded as 6 floats: the basis columns (a, b) and (c, d), then the offset,
+// giving world = [a c; b d] * local + offset in the vertex shader.
+class Transform2D
+{
+public:
+    static constexpr int PACKED_FLOATS = 6;
+
+private:
+    float m_x = 0.0f, m_y = 0.0f;
+    float m_rotation = 0.0f;  // radians, counter-clockwise
+    float m_scale_x  = 1.0f, m_scale_y = 1.0f;
+
+    mutable float m_packed[PACKED_FLOATS] = { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f };
+    mutable bool  m_basis_dirty = false;
+
+public:
+    Transform2D() { }
+    Transform2D(float x, float y, float rotation = 0.0f, float scale_x = 1.0f, float scale_y = 1.0f)
+    {
+        set_position(x, y);
+        set_rotation(rotation);
+        set_scale(scale_x, scale_y);
+    }
+
+    void set_position(float x, float y) { m_x = x; m_y = y; }
+
+    void set_rotation(float radians)
+    {
+        if (radians == m_rotation) return;
+        m_rotation    = radians;
+        m_basis_dirty = true;
+    }
+
+    void set_scale(float scale_x, float scale_y)
+    {
+        if (scale_x == m_scale_x && scale_y == m_scale_y) return;
+        m_scale_x     = scale_x;
+        m_scale_y     = scale_y;
+        m_basis_dirty = true;
+    }
+
+    float const get_x()        const { return m_x;        }
+    float const get_y()        const { return m_y;        }
+    float const get_rotation() const { return m_rotation; }
+    float const get_scale_x()  const { return m_scale_x;  }
+    float const get_scale_y()  const { return m_scale_y;  }
+
+    const float* packed() const
+    {
+        if (m_basis_dirty)
+        {
+            float s, c;
+            fast_sincos(m_rotation, &s, &c);
+
+            m_packed[0] =  c * m_scale_x;
+            m_packed[1] =  s * m_scale_x;
+            m_packed[2] = -s * m_scale_y;
+            m_packed[3] =  c * m_scale_y;
+            m_basis_dirty = false;
+        }
+
+        m_packed[4] = m_x;
+        m_packed[5] = m_y;
+
+        return m_packed;
+    }
+};
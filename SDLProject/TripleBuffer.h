@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer hand-off of whole values. The
+// writer fills its back slot and publishes it; the reader picks up the most
+// recently published slot whenever it likes. Neither side ever waits, and a
+// slow reader just skips intermediate values.
+//
+// The writer must fill every field it cares about before each publish(): the
+// back slot it gets handed holds whatever was published two rounds earlier.
+template <typename T>
+class TripleBuffer
+{
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH_BIT  = 0x4;  // middle slot holds data the reader hasn't seen
+
+    T m_slots[3];
+
+    std::atomic<uint8_t> m_middle;
+    int m_back  = 0;  // owned by the writer
+    int m_front = 1;  // owned by the reader
+
+public:
+    TripleBuffer() : m_middle(2) { }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // ————— WRITER ————— //
+    T& write_buffer() { return m_slots[m_back]; }
+
+    void publish()
+    {
+        uint8_t previous = m_middle.exchange((uint8_t) (m_back | FRESH_BIT), std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+    }
+
+    // ————— READER ————— //
+    // Swaps in the latest published value; returns false if there wasn't a new one
+    bool update()
+    {
+        if (!(m_middle.load(std::memory_order_relaxed) & FRESH_BIT)) return false;
+
+        uint8_t previous = m_middle.exchange((uint8_t) m_front, std::memory_order_acq_rel);
+        m_front = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T& read_buffer() const { return m_slots[m_front]; }
+};
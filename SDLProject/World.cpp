@@ -0,0 +1,72 @@
+#include "World.h"
+#include <cassert>
+
+// Ids are the slot index in the low 24 bits and the slot's generation above
+// them, so a stale id stops matching once its slot is reused
+static EntityId make_id(uint32_t index, uint8_t generation)
+{
+    return ((EntityId) generation << ENTITY_INDEX_BITS) | index;
+}
+
+EntityId World::create()
+{
+    uint32_t index;
+    if (!m_free.empty())
+    {
+        index = m_free.back();
+        m_free.pop_back();
+    }
+    else
+    {
+        index = (uint32_t) m_generations.size();
+        // The last index is left out: at its last generation it would spell NO_ENTITY
+        assert(index < MAX_ENTITIES - 1 && "World is out of entity slots");
+        m_generations.push_back(0);
+        m_alive.push_back(false);
+    }
+
+    m_alive[index] = true;
+    return make_id(index, m_generations[index]);
+}
+
+void World::destroy(EntityId entity)
+{
+    if (!is_alive(entity)) return;
+
+    m_transforms.remove(entity);
+    m_velocities.remove(entity);
+    m_colliders.remove(entity);
+    m_fuel.remove(entity);
+    m_ai.remove(entity);
+    m_sprites.remove(entity);
+
+    uint32_t index = ComponentPool<Transform>::index_of(entity);
+    m_alive[index] = false;
+
+    // Another lap of the generations would let handles from the first lap
+    // match again, so a worn-out slot is never handed out again
+    if (m_generations[index] == LAST_GENERATION) return;
+
+    m_generations[index]++;
+    m_free.push_back(index);
+}
+
+bool World::is_alive(EntityId entity) const
+{
+    uint32_t index = ComponentPool<Transform>::index_of(entity);
+    return index < m_alive.size() && m_alive[index] && make_id(index, m_generations[index]) == entity;
+}
+
+void World::reserve(size_t count)
+{
+    m_generations.reserve(count);
+    m_alive.reserve(count);
+    m_free.reserve(count);
+
+    m_transforms.reserve(count);
+    m_velocities.reserve(count);
+    m_colliders.reserve(count);
+    m_fuel.reserve(count);
+    m_ai.reserve(count);
+    m_sprites.reserve(count);
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <cassert>
+#include "Components.h"
+
+// Handle to an entity: an index into the world's slots (low 24 bits) plus the
+// slot's generation when it was made (high 8), so a handle outlives its
+// entity safely. A slot is retired rather than reused once its generation
+// runs out, so an old handle can never come back to life.
+typedef uint32_t EntityId;
+constexpr EntityId NO_ENTITY = 0xFFFFFFFF;
+
+constexpr uint32_t ENTITY_INDEX_BITS = 24;
+constexpr uint32_t MAX_ENTITIES      = 1u << ENTITY_INDEX_BITS;
+constexpr uint32_t LAST_GENERATION   = 0xFF;
+
+// One component type's storage as a sparse set: the components themselves
+// packed in a dense array (swap-removed, so it never has holes), which
+// entity owns each, and per entity index where its component sits.
+//
+// Systems walk the dense array front to back. Entities given the same
+// components in the same order sit at the same position in every pool, so
+// find() is handed that position as a hint and only falls back to the sparse
+// lookup when it's wrong.
+template <typename T>
+class ComponentPool
+{
+public:
+    static constexpr uint32_t ABSENT = 0xFFFFFFFF;
+
+private:
+    std::vector<T>        m_dense;
+    std::vector<EntityId> m_owners;
+    std::vector<uint32_t> m_sparse;  // by entity index
+
+public:
+    static uint32_t index_of(EntityId entity) { return entity & (MAX_ENTITIES - 1); }
+
+    T& add(EntityId entity, const T &component)
+    {
+        uint32_t index = index_of(entity);
+        if (index >= m_sparse.size()) m_sparse.resize(index + 1, ABSENT);
+
+        // Its slot may still hold a stale handle's component (the pool only
+        // hears about destroys through World); the new handle takes it over
+        uint32_t slot = m_sparse[index];
+        if (slot != ABSENT)
+        {
+            m_owners[slot] = entity;
+            return m_dense[slot] = component;
+        }
+
+        m_sparse[index] = (uint32_t) m_dense.size();
+        m_dense.push_back(component);
+        m_owners.push_back(entity);
+        return m_dense.back();
+    }
+
+    void remove(EntityId entity)
+    {
+        // A stale handle mustn't take the component of whoever has its slot now
+        if (!has(entity)) return;
+
+        // The last one moves into the gap
+        uint32_t index = index_of(entity);
+        uint32_t slot  = m_sparse[index];
+        m_dense[slot]  = m_dense.back();
+        m_owners[slot] = m_owners.back();
+        m_sparse[index_of(m_owners[slot])] = slot;
+
+        m_dense.pop_back();
+        m_owners.pop_back();
+        m_sparse[index] = ABSENT;
+    }
+
+    bool has(EntityId entity) const
+    {
+        uint32_t index = index_of(entity);
+        return index < m_sparse.size() && m_sparse[index] != ABSENT && m_owners[m_sparse[index]] == entity;
+    }
+
+    T* get(EntityId entity) { return has(entity) ? &m_dense[m_sparse[index_of(entity)]] : nullptr; }
+    const T* get(EntityId entity) const { return has(entity) ? &m_dense[m_sparse[index_of(entity)]] : nullptr; }
+
+    // get() that tries dense position `hint` first
+    T* find(EntityId entity, size_t hint)
+    {
+        if (hint < m_owners.size() && m_owners[hint] == entity) return &m_dense[hint];
+        return get(entity);
+    }
+
+    void reserve(size_t count)
+    {
+        m_dense.reserve(count);
+        m_owners.reserve(count);
+        m_sparse.reserve(count);
+    }
+
+    size_t size() const { return m_dense.size(); }
+    T*       data()       { return m_dense.data(); }
+    const T* data() const { return m_dense.data(); }
+    EntityId owner(size_t position) const { return m_owners[position]; }
+};
+
+template <typename T> constexpr uint32_t ComponentPool<T>::ABSENT;
+
+// Entities and their components. An entity is nothing but an id; what it is
+// comes from which pools hold a component for it.
+class World
+{
+private:
+    std::vector<uint8_t>  m_generations;  // per slot, bumped when its entity is destroyed
+    std::vector<bool>     m_alive;
+    std::vector<uint32_t> m_free;  // slots with a generation left to hand out
+
+    ComponentPool<Transform> m_transforms;
+    ComponentPool<Velocity>  m_velocities;
+    ComponentPool<Collider>  m_colliders;
+    ComponentPool<Fuel>      m_fuel;
+    ComponentPool<AI>        m_ai;
+    ComponentPool<Sprite>    m_sprites;
+
+public:
+    // Asserts there's still a slot to give (MAX_ENTITIES - 1 of them, less
+    // the retired ones)
+    EntityId create();
+    void     destroy(EntityId entity);
+    bool     is_alive(EntityId entity) const;
+
+    // Room for `count` entities with every component, so adding them later
+    // doesn't allocate
+    void reserve(size_t count);
+
+    template <typename T> ComponentPool<T>& pool();
+    template <typename T> const ComponentPool<T>& pool() const { return const_cast<World*>(this)->pool<T>(); }
+
+    // Adding to a dead entity is a bug; removing from one does nothing
+    template <typename T> T& add(EntityId entity, const T &component = T())
+    {
+        assert(is_alive(entity) && "Adding a component to a dead entity");
+        return pool<T>().add(entity, component);
+    }
+    template <typename T> void remove(EntityId entity) { if (is_alive(entity)) pool<T>().remove(entity); }
+    template <typename T> bool has(EntityId entity) const { return pool<T>().has(entity); }
+    template <typename T> T* get(EntityId entity) { return pool<T>().get(entity); }
+    template <typename T> const T* get(EntityId entity) const { return pool<T>().get(entity); }
+};
+
+template <> inline ComponentPool<Transform>& World::pool<Transform>() { return m_transforms; }
+template <> inline ComponentPool<Velocity>&  World::pool<Velocity>()  { return m_velocities; }
+template <> inline ComponentPool<Collider>&  World::pool<Collider>()  { return m_colliders;  }
+template <> inline ComponentPool<Fuel>&      World::pool<Fuel>()      { return m_fuel;       }
+template <> inline ComponentPool<AI>&        World::pool<AI>()        { return m_ai;         }
+template <> inline ComponentPool<Sprite>&    World::pool<Sprite>()    { return m_sprites;    }
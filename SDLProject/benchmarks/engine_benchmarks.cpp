@@ -0,0 +1,649 @@
+/**
+* Microbenchmarks for the engine's hot paths, built on Google Benchmark.
+*
+* Nothing here needs a window or a GL context: Map only touches GL on its
+* first render, and the decode benchmark calls stb_image directly.
+*
+* Build from SDLProject/ (the benchmarks load the game's PNGs from there):
+*
+*   c++ -std=c++14 -O2 -DNDEBUG -I. $(sdl2-config --cflags) \
+*       benchmarks/engine_benchmarks.cpp World.cpp Systems.cpp LanderPhysics.cpp Autopilot.cpp PolicyTable.cpp LanderEnv.cpp Map.cpp \
+*       DistanceField.cpp OccupancyPyramid.cpp Mesh.cpp GLState.cpp ShaderProgram.cpp TextLabel.cpp ParticleSystem.cpp \
+*       SpriteBatch.cpp AllocationTracker.cpp \
+*       -lbenchmark -lpthread $(sdl2-config --libs) -lGL -o engine_benchmarks
+*
+* (on macOS swap -lGL for -framework OpenGL)
+*
+* Run with JSON output:
+*
+*   ./engine_benchmarks --benchmark_format=json --benchmark_out=results.json
+*
+* Add --benchmark_filter=<regex> to run a subset.
+**/
+#define STB_IMAGE_IMPLEMENTATION
+#define GL_SILENCE_DEPRECATION
+#define GL_GLEXT_PROTOTYPES 1
+
+#include <benchmark/benchmark.h>
+#include "World.h"
+#include "Systems.h"
+#include "Map.h"
+#include "LanderPhysics.h"
+#include "Autopilot.h"
+#include "LanderEnv.h"
+#include "FastTrig.h"
+#include "ParticleSystem.h"
+#include "TextLabel.h"
+#include "stb_image.h"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// ————— FIXTURES ————— //
+// Rolling terrain like the real level: empty sky, a ragged surface of dirt
+// (1), rock (2) and landing pads (3), solid below
+static std::vector<unsigned int> make_level(int width, int height, unsigned seed = 1)
+{
+    std::vector<unsigned int> level(width * height, 0);
+    std::mt19937 random(seed);
+
+    int surface = height / 2;
+    for (int x = 0; x < width; x++)
+    {
+        surface += (int) (random() % 3) - 1;
+        if (surface < 1)          surface = 1;
+        if (surface > height - 1) surface = height - 1;
+
+        for (int y = surface; y < height; y++)
+        {
+            level[y * width + x] = y == surface ? 1 + random() % 3 : 1;
+        }
+    }
+    return level;
+}
+
+// Points spread over the whole map, in world space (y runs downwards from 0)
+static std::vector<glm::vec3> make_points(const Map &map, int count, unsigned seed = 2)
+{
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> x_coord(map.get_left_bound(), map.get_right_bound());
+    std::uniform_real_distribution<float> y_coord(map.get_bottom_bound(), map.get_top_bound());
+
+    std::vector<glm::vec3> points(count);
+    for (glm::vec3 &point : points) point = glm::vec3(x_coord(random), y_coord(random), 0.0f);
+    return points;
+}
+
+// A thrusting lander with everything the game's player has but a sprite
+static EntityId make_lander(World &world)
+{
+    EntityId lander = world.create();
+    world.add<Transform>(lander);
+    world.add<Velocity>(lander);
+    world.add<Collider>(lander);
+    world.add<Fuel>(lander);
+    world.add<AI>(lander).input.thrust = true;
+    return lander;
+}
+
+// A row of static colliders far enough away that none of them collide
+static void make_obstacles(World &world, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        EntityId obstacle = world.create();
+        Transform &transform = world.add<Transform>(obstacle);
+        transform.x = 1000.0f + 2.0f * i;
+        transform.y = 1000.0f;
+        world.add<Collider>(obstacle);
+    }
+}
+
+static bool read_file(const char *filepath, std::vector<unsigned char> &bytes)
+{
+    FILE *file = fopen(filepath, "rb");
+    if (file == nullptr) return false;
+
+    fseek(file, 0, SEEK_END);
+    bytes.resize(ftell(file));
+    fseek(file, 0, SEEK_SET);
+    size_t read = fread(bytes.data(), 1, bytes.size(), file);
+    fclose(file);
+
+    return read == bytes.size();
+}
+
+// ————— WORLD ————— //
+static void place(World &world, EntityId entity, float x, float y, float velocity_x, float velocity_y)
+{
+    Transform &transform = *world.get<Transform>(entity);
+    Velocity  &velocity  = *world.get<Velocity>(entity);
+    transform.x = x;
+    transform.y = y;
+    velocity.x  = velocity_x;
+    velocity.y  = velocity_y;
+    *world.get<Collider>(entity) = Collider();
+}
+
+// One fixed step of a thrusting lander over a 20x7 map, against N static colliders
+static void BM_WorldStep(benchmark::State &state)
+{
+    std::vector<unsigned int> level = make_level(20, 7);
+    Map map(20, 7, level.data(), 0, 1.0f, 4, 1);
+
+    World world;
+    EntityId lander = make_lander(world);
+    make_obstacles(world, (int) state.range(0));
+
+    for (auto _ : state)
+    {
+        // Keep it in open sky so every step takes the same path
+        place(world, lander, 3.0f, 2.0f, 0.5f, -0.5f);
+        world.get<Fuel>(lander)->amount = 500.0f;
+        Systems::step(world, &map, 0.0166666f);
+        benchmark::DoNotOptimize(world.get<Transform>(lander)->x);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WorldStep)->Arg(0)->Arg(8)->Arg(64)->Arg(512);
+
+// One fixed step of N landers spread across a 256x64 map: how a step scales
+// with the number of movers, walking each component array once
+static void BM_WorldStepMovers(benchmark::State &state)
+{
+    std::vector<unsigned int> level = make_level(256, 64);
+    Map map(256, 64, level.data(), 0, 1.0f, 4, 1);
+    std::vector<glm::vec3> points = make_points(map, (int) state.range(0));
+
+    World world;
+    world.reserve(points.size());
+    for (size_t i = 0; i < points.size(); i++) make_lander(world);
+
+    Transform *transforms = world.pool<Transform>().data();
+    Velocity  *velocities = world.pool<Velocity>().data();
+    Collider  *colliders  = world.pool<Collider>().data();
+    Fuel      *fuel       = world.pool<Fuel>().data();
+
+    for (auto _ : state)
+    {
+        // Everyone back where they started, so crashes don't thin the field
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            transforms[i].x = points[i].x;
+            transforms[i].y = points[i].y;
+            velocities[i].x = 0.5f;
+            velocities[i].y = -0.5f;
+            colliders[i]    = Collider();
+            fuel[i].amount  = 500.0f;
+        }
+        Systems::step(world, &map, 0.0166666f);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WorldStepMovers)->RangeMultiplier(8)->Range(8, 32768);
+
+// One lander checked against N static colliders, none of them touching
+static void BM_CollideStatics(benchmark::State &state)
+{
+    World world;
+    EntityId lander = make_lander(world);
+    make_obstacles(world, (int) state.range(0));
+
+    for (auto _ : state)
+    {
+        Systems::collide(world, nullptr, 0, 1);
+        benchmark::ClobberMemory();
+    }
+    benchmark::DoNotOptimize(world.get<Collider>(lander)->finished);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CollideStatics)->RangeMultiplier(8)->Range(1, 4096);
+
+// The map half of collide, at N positions spread over a 256x64 map (both
+// axes, with the open-sky skip). Each pass resets the landers so collision
+// responses don't accumulate.
+static void BM_CollideMap(benchmark::State &state)
+{
+    std::vector<unsigned int> level = make_level(256, 64);
+    Map map(256, 64, level.data(), 0, 1.0f, 4, 1);
+    std::vector<glm::vec3> points = make_points(map, (int) state.range(0));
+
+    World world;
+    world.reserve(points.size());
+    for (size_t i = 0; i < points.size(); i++) make_lander(world);
+
+    Transform *transforms = world.pool<Transform>().data();
+    Velocity  *velocities = world.pool<Velocity>().data();
+    Collider  *colliders  = world.pool<Collider>().data();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            transforms[i].x = points[i].x;
+            transforms[i].y = points[i].y;
+            velocities[i].x = 1.0f;
+            velocities[i].y = -1.0f;
+            colliders[i]    = Collider();
+        }
+        Systems::collide(world, &map, 0, points.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CollideMap)->RangeMultiplier(8)->Range(8, 4096);
+
+// ————— MAP ————— //
+// N random probes against a square map of side M: args are {N, M}
+static void BM_MapIsSolid(benchmark::State &state)
+{
+    int side = (int) state.range(1);
+    std::vector<unsigned int> level = make_level(side, side);
+    Map map(side, side, level.data(), 0, 1.0f, 4, 1);
+    std::vector<glm::vec3> points = make_points(map, (int) state.range(0));
+
+    for (auto _ : state)
+    {
+        int solid = 0;
+        float penetration_x, penetration_y;
+        for (const glm::vec3 &point : points) solid += map.is_solid(point, &penetration_x, &penetration_y);
+        benchmark::DoNotOptimize(solid);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapIsSolid)->ArgsProduct({ { 64, 4096 }, { 16, 256, 2048 } });
+
+// The same probes through is_solid_batch, as split x/y arrays
+static void BM_MapIsSolidBatch(benchmark::State &state)
+{
+    int side  = (int) state.range(1);
+    int count = (int) state.range(0);
+    std::vector<unsigned int> level = make_level(side, side);
+    Map map(side, side, level.data(), 0, 1.0f, 4, 1);
+    std::vector<glm::vec3> points = make_points(map, count);
+
+    std::vector<float> xs(count), ys(count), penetration_x(count), penetration_y(count);
+    std::vector<int>   tile_types(count);
+    std::vector<unsigned int> solid_bits((count + 31) / 32);
+    for (int i = 0; i < count; i++) { xs[i] = points[i].x; ys[i] = points[i].y; }
+
+    Map::ProbeResults results;
+    results.tile_types    = tile_types.data();
+    results.penetration_x = penetration_x.data();
+    results.penetration_y = penetration_y.data();
+    results.solid_bits    = solid_bits.data();
+
+    for (auto _ : state)
+    {
+        int solid = map.is_solid_batch(xs.data(), ys.data(), count, results);
+        benchmark::DoNotOptimize(solid);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapIsSolidBatch)->ArgsProduct({ { 64, 4096 }, { 16, 256, 2048 } });
+
+static void BM_MapGetTileType(benchmark::State &state)
+{
+    int side = (int) state.range(1);
+    std::vector<unsigned int> level = make_level(side, side);
+    Map map(side, side, level.data(), 0, 1.0f, 4, 1);
+
+    // Includes some out-of-bounds lookups, like the collision code makes
+    std::mt19937 random(3);
+    std::uniform_int_distribution<int> coord(-2, side + 1);
+    std::vector<int> tiles(state.range(0) * 2);
+    for (int &tile : tiles) tile = coord(random);
+
+    for (auto _ : state)
+    {
+        int sum = 0;
+        for (size_t i = 0; i < tiles.size(); i += 2) sum += map.get_tile_type(tiles[i], tiles[i + 1]);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapGetTileType)->ArgsProduct({ { 64, 4096 }, { 16, 256, 2048 } });
+
+// N random rays of up to 32 units over a square map of side M: args are {N, M}
+static void BM_MapRaycastBatch(benchmark::State &state)
+{
+    int side  = (int) state.range(1);
+    int count = (int) state.range(0);
+    std::vector<unsigned int> level = make_level(side, side);
+    Map map(side, side, level.data(), 0, 1.0f, 4, 1);
+    std::vector<glm::vec3> points = make_points(map, count);
+
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::vector<float> origin_x(count), origin_y(count), direction_x(count), direction_y(count);
+    for (int i = 0; i < count; i++)
+    {
+        float a = angle(random);
+        origin_x[i]    = points[i].x;
+        origin_y[i]    = points[i].y;
+        direction_x[i] = cosf(a);
+        direction_y[i] = sinf(a);
+    }
+    std::vector<Map::RaycastHit> hits(count);
+
+    for (auto _ : state)
+    {
+        map.raycast_batch(origin_x.data(), origin_y.data(), direction_x.data(), direction_y.data(),
+                          count, 32.0f, hits.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapRaycastBatch)->ArgsProduct({ { 64, 4096 }, { 16, 256, 2048 } });
+
+// N random boxes of up to 8x8 tiles against a square map of side M: args are {N, M}
+static void BM_MapIsRegionEmpty(benchmark::State &state)
+{
+    int side = (int) state.range(1);
+    std::vector<unsigned int> level = make_level(side, side);
+    Map map(side, side, level.data(), 0, 1.0f, 4, 1);
+    std::vector<glm::vec3> points = make_points(map, (int) state.range(0));
+
+    std::mt19937 random(13);
+    std::uniform_real_distribution<float> extent(0.5f, 8.0f);
+    std::vector<glm::vec3> sizes(points.size());
+    for (glm::vec3 &size : sizes) size = glm::vec3(extent(random), extent(random), 0.0f);
+
+    for (auto _ : state)
+    {
+        int empty = 0;
+        for (size_t i = 0; i < points.size(); i++) empty += map.is_region_empty(points[i], points[i] + sizes[i]);
+        benchmark::DoNotOptimize(empty);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapIsRegionEmpty)->ArgsProduct({ { 64, 4096 }, { 16, 256, 2048 } });
+
+// Building the solid/empty/pad distance fields for a square map of side N
+static void BM_MapBuildDistanceFields(benchmark::State &state)
+{
+    int side = (int) state.range(0);
+    std::vector<unsigned int> level = make_level(side, side);
+    Map map(side, side, level.data(), 0, 1.0f, 4, 1);
+
+    for (auto _ : state)
+    {
+        map.build_distance_fields();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * side * side);
+}
+BENCHMARK(BM_MapBuildDistanceFields)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMicrosecond);
+
+// Toggling one random tile and bringing a solid field back up to date
+static void BM_DistanceFieldUpdate(benchmark::State &state)
+{
+    int side = (int) state.range(0);
+    std::vector<unsigned int> level = make_level(side, side);
+    DistanceField field;
+    field.build(level.data(), side, side, [](unsigned int tile) { return tile != 0; });
+
+    std::mt19937 random(11);
+    std::uniform_int_distribution<int> coord(0, side - 1);
+
+    for (auto _ : state)
+    {
+        int x = coord(random), y = coord(random);
+        level[y * side + x] = level[y * side + x] ? 0 : 1;
+        field.update_tile(level.data(), x, y);
+    }
+}
+BENCHMARK(BM_DistanceFieldUpdate)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMicrosecond);
+
+// N clearance queries against a square map of side M: args are {N, M}
+static void BM_MapSolidDistance(benchmark::State &state)
+{
+    int side = (int) state.range(1);
+    std::vector<unsigned int> level = make_level(side, side);
+    Map map(side, side, level.data(), 0, 1.0f, 4, 1);
+    map.build_distance_fields();
+    std::vector<glm::vec3> points = make_points(map, (int) state.range(0));
+
+    for (auto _ : state)
+    {
+        float sum = 0.0f;
+        for (const glm::vec3 &point : points) sum += map.solid_distance(point);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapSolidDistance)->ArgsProduct({ { 64, 4096 }, { 16, 256, 2048 } });
+
+// Rebuilding the tile geometry of a square map of side N
+static void BM_MapBuild(benchmark::State &state)
+{
+    int side = (int) state.range(0);
+    std::vector<unsigned int> level = make_level(side, side);
+    Map map(side, side, level.data(), 0, 1.0f, 4, 1);
+
+    for (auto _ : state)
+    {
+        map.build();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * side * side);
+}
+BENCHMARK(BM_MapBuild)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMicrosecond);
+
+// ————— TEXT ————— //
+// The tessellation behind draw_text and TextLabel, for strings of N characters
+static void BM_TextTessellate(benchmark::State &state)
+{
+    int length = (int) state.range(0);
+    std::vector<char> text(length + 1);
+    for (int i = 0; i < length; i++) text[i] = (char) ('0' + i % 75);
+    text[length] = '\0';
+
+    std::vector<float> vertices(length * TextLabel::FLOATS_PER_GLYPH);
+
+    for (auto _ : state)
+    {
+        TextLabel::tessellate(text.data(), length, 0.5f, 0.05f, vertices.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+}
+BENCHMARK(BM_TextTessellate)->RangeMultiplier(4)->Range(4, 1024);
+
+// ————— TEXTURES ————— //
+// load_texture's decode step, on each of the game's images (font, tiles,
+// sprites, end screens). The file is read once up front so only decoding is timed.
+static const char *const DECODE_IMAGES[] = { "font1.png", "tileset.png", "vamp.png", "bat.png",
+                                             "missionComp.png", "missionFail.png" };
+
+static void BM_DecodePNG(benchmark::State &state)
+{
+    const char *filepath = DECODE_IMAGES[state.range(0)];
+    std::vector<unsigned char> bytes;
+    if (!read_file(filepath, bytes))
+    {
+        state.SkipWithError("image not found; run from SDLProject/");
+        return;
+    }
+
+    int width = 0, height = 0;
+    for (auto _ : state)
+    {
+        int components;
+        unsigned char *image = stbi_load_from_memory(bytes.data(), (int) bytes.size(),
+                                                     &width, &height, &components, STBI_rgb_alpha);
+        benchmark::DoNotOptimize(image);
+        stbi_image_free(image);
+    }
+
+    state.SetLabel(filepath);
+    state.SetBytesProcessed(state.iterations() * (int64_t) width * height * 4);
+}
+BENCHMARK(BM_DecodePNG)->DenseRange(0, 5)->Unit(benchmark::kMicrosecond);
+
+// ————— LANDER PHYSICS ————— //
+// The bare flight model over a batch of landers, the shape autopilot rollouts
+// and batch simulation will use: one integrate per lander per step
+static void BM_LanderIntegrate(benchmark::State &state)
+{
+    const int n = (int) state.range(0);
+    std::vector<LanderState> landers(n);
+    std::vector<LanderInput> inputs(n);
+
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (int i = 0; i < n; i++)
+    {
+        landers[i].angle  = unit(rng) * 3.0f;
+        landers[i].fuel   = 1.0e9f;
+        inputs[i].torque  = unit(rng);
+        inputs[i].thrust  = (i & 1) != 0;
+    }
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < n; i++) LanderPhysics::integrate(landers[i], inputs[i], 1.0f / 60.0f);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_LanderIntegrate)->RangeMultiplier(16)->Range(1, 65536);
+
+// One full autopilot step (every candidate rolled out, no time budget) from
+// above a rolling level, with the pad a few tiles off to the side
+static void BM_AutopilotUpdate(benchmark::State &state)
+{
+    std::vector<unsigned int> level = make_level(64, 16);
+    Map map(64, 16, level.data(), 0, 1.0f, 4, 1);
+    map.build_distance_fields();
+
+    Autopilot autopilot(&map, 1.0f, 1.0f);
+    autopilot.set_budget(1000.0f);
+
+    LanderState lander;
+    lander.x    = 32.0f;
+    lander.y    = 2.0f;
+    lander.fuel = 500.0f;
+
+    int rollouts = 0;
+    for (auto _ : state)
+    {
+        LanderInput input = autopilot.update(lander, 1.0f / 60.0f);
+        benchmark::DoNotOptimize(input);
+        rollouts += autopilot.get_stats().rollouts;
+    }
+
+    state.counters["rollouts"] = benchmark::Counter(rollouts, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_AutopilotUpdate)->Unit(benchmark::kMicrosecond);
+
+// One LanderEnv step of `n` environments on `threads` threads, each flown by
+// a bang-bang hover that reads its observation row in place. Anything that
+// finishes starts again, so every environment is live every iteration.
+static void BM_LanderEnvStep(benchmark::State &state)
+{
+    const int n       = (int) state.range(0);
+    const int threads = (int) state.range(1);
+
+    std::vector<unsigned int> level = make_level(20, 7);
+    Map map(20, 7, level.data(), 0, 1.0f, 4, 1);
+
+    LanderEnv::Settings settings;
+    settings.threads = threads;
+    LanderEnv env(&map, n, settings);
+
+    std::vector<uint32_t> seeds(n);
+    for (int i = 0; i < n; i++) seeds[i] = (uint32_t) i;
+    LanderEnv::Batch batch = env.reset(seeds.data());
+
+    std::vector<LanderInput> inputs(n);
+    for (auto _ : state)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            const float *observation = batch.observations + (size_t) i * LanderEnv::OBSERVATION_SIZE;
+            inputs[i].torque = -observation[LanderEnv::SIN_ANGLE];
+            inputs[i].thrust = observation[LanderEnv::VELOCITY_Y] < 0.0f;
+        }
+        batch = env.step(inputs.data());
+
+        for (int i = 0; i < n; i++)
+        {
+            if (batch.dones[i]) env.reset(i, seeds[i] += n);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(std::to_string(env.get_thread_count()) + " threads");
+}
+BENCHMARK(BM_LanderEnvStep)->Args({ 1, 1 })->Args({ 1024, 1 })->Args({ 1024, 4 })->Unit(benchmark::kMicrosecond);
+
+// fast_sincos against the libm pair it replaces, over lander-sized angles
+static void BM_SinCos(benchmark::State &state)
+{
+    const bool fast = state.range(0) != 0;
+    std::vector<float> angles(1024);
+    for (int i = 0; i < 1024; i++) angles[i] = (i - 512) * 0.0123f;
+
+    for (auto _ : state)
+    {
+        float sum = 0.0f;
+        for (float angle : angles)
+        {
+            float sine, cosine;
+            if (fast) fast_sincos(angle, &sine, &cosine);
+            else      { sine = sinf(angle); cosine = cosf(angle); }
+            sum += sine + cosine;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetLabel(fast ? "fast_sincos" : "sinf+cosf");
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_SinCos)->Arg(0)->Arg(1);
+
+// ————— PARTICLES ————— //
+// One 60 Hz update of a full pool. Lives are long enough that nothing dies
+// mid-run, so every iteration integrates `n` particles; the budget is 16.6ms.
+// Drag keeps shrinking the velocities, so the pool is refilled every
+// PARTICLE_REFILL_STEPS (10 seconds of game time) before they sink into
+// denormals and the timing stops being anything the game would see.
+static const int PARTICLE_REFILL_STEPS = 600;
+
+static void BM_ParticleUpdate(benchmark::State &state)
+{
+    const int n = (int) state.range(0);
+    ParticleSystem particles(n);
+
+    ParticleSystem::Emitter emitter;
+    emitter.position_jitter = 2.0f;
+    emitter.velocity_jitter = 1.0f;
+    emitter.life            = 1.0e6f;
+    particles.emit(emitter, n);
+
+    int steps = 0;
+    for (auto _ : state)
+    {
+        if (++steps == PARTICLE_REFILL_STEPS)
+        {
+            state.PauseTiming();
+            particles.clear();
+            particles.emit(emitter, n);
+            steps = 0;
+            state.ResumeTiming();
+        }
+
+        particles.update(1.0f / 60.0f);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * (int64_t) particles.get_count());
+}
+BENCHMARK(BM_ParticleUpdate)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
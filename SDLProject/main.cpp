@@ -27,13 +27,33 @@
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "ShaderProgram.h"
+#include "GLState.h"
+#include "Mesh.h"
 #include "stb_image.h"
-#include "Entity.h"
+#include "World.h"
+#include "Systems.h"
 #include <vector>
 #include <ctime>
 #include "cmath"
 #include "Map.h"
+#include "TextLabel.h"
+#include "FrameScheduler.h"
+#include "TripleBuffer.h"
+#include "HeadlessContext.h"
+#include "AllocationTracker.h"
+#include "PerfHud.h"
+#include "ParticleSystem.h"
+#include "SpriteBatch.h"
+#include "Autopilot.h"
+#include "PolicyTable.h"
 #include <string>
+#include <cstring>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
 
 // ————— CONSTANTS ————— //
 constexpr int WINDOW_WIDTH  = 640 * 2,
@@ -49,11 +69,53 @@ constexpr int VIEWPORT_X = 0,
               VIEWPORT_WIDTH  = WINDOW_WIDTH,
               VIEWPORT_HEIGHT = WINDOW_HEIGHT;
 
+#ifdef USE_LEGACY_GL
 constexpr char V_SHADER_PATH[] = "shaders/vertex_textured.glsl",
                F_SHADER_PATH[] = "shaders/fragment_textured.glsl";
 
+// No instancing here: particles go through the regular program, untinted
+constexpr char PARTICLE_V_SHADER_PATH[] = "shaders/vertex_textured.glsl",
+               PARTICLE_F_SHADER_PATH[] = "shaders/fragment_textured.glsl";
+#else
+constexpr char V_SHADER_PATH[] = "shaders/vertex_textured_330.glsl",
+               F_SHADER_PATH[] = "shaders/fragment_textured_330.glsl";
+
+constexpr char PARTICLE_V_SHADER_PATH[] = "shaders/vertex_instanced_330.glsl",
+               PARTICLE_F_SHADER_PATH[] = "shaders/fragment_instanced_330.glsl";
+#endif
+
 constexpr float MILLISECONDS_IN_SECOND = 1000.0;
 
+// Frame cap used when vsync isn't available and no --fps was given
+constexpr float DEFAULT_FRAME_RATE = 60.0f;
+
+// How long an idle loop blocks waiting for events before re-checking its state
+constexpr int IDLE_WAIT_MILLISECONDS = 250;
+
+// After a long stall, drop the backlog instead of fast-forwarding through it
+constexpr int MAX_STEPS_PER_UPDATE = 8;
+
+// ————— PARTICLES ————— //
+constexpr float EXHAUST_PER_SECOND   = 600.0f;
+constexpr int   CRASH_DEBRIS_COUNT   = 400;
+constexpr int   CRASH_SPARK_COUNT    = 200;
+constexpr float CRASH_SECONDS        = 1.5f;   // debris plays out before the end screen
+constexpr float MAX_PARTICLE_STEP    = 0.1f;   // longest frame the particles integrate in one go
+constexpr int   PARTICLE_TEXTURE_SIZE = 16;
+
+// Frames to let pass (first uploads, label text settling) before --zero-alloc
+// starts failing frames that allocate
+constexpr int ZERO_ALLOC_WARMUP_FRAMES = 120;
+
+// Y-position threshold for falling off the screen as the lander did not land
+constexpr float FALL_THRESHOLD = -5.5f;
+
+// How far below the lander the altimeter looks for ground
+constexpr float ALTIMETER_RANGE = 100.0f;
+
+// Clearance (lander edge to nearest terrain) under which the HUD warns
+constexpr float PROXIMITY_WARNING_DISTANCE = 0.6f;
+
 constexpr glm::vec3 PLAYER_IDLE_LOCATION = glm::vec3(3.0f, 2.0f, 0.0f);
 constexpr glm::vec3 INIT_FINAL_SCREEN_SCALE = glm::vec3(4.0f, 4.0f, 1.0f);
 
@@ -62,31 +124,100 @@ ACCOMPLISHED_FILEPATH[] = "missionComp.png",
 FAILED_FILEPATH[] = "missionFail.png";
 
 constexpr char FONTSHEET_FILEPATH[]   = "font1.png";
-constexpr int FONTBANK_SIZE = 16;
 
 // ————— STRUCTS AND ENUMS —————//
 enum AppStatus  { RUNNING, TERMINATED };
 enum FilterType { NEAREST, LINEAR     };
 
-struct GameState { Entity* player; Map* map; };
+struct GameState { World* world; EntityId player; Map* map; };
+
+// Player input sampled on the main thread, read by the simulation each step
+enum InputBits { INPUT_THRUST = 1 << 0, INPUT_ROTATE_RIGHT = 1 << 1,
+                 INPUT_ROTATE_LEFT = 1 << 2, INPUT_ROTATE_UP = 1 << 3 };
+
+// Everything render() needs from the simulation, copied out after each batch
+// of fixed steps so drawing never reads live physics state
+struct RenderSnapshot
+{
+    Sprite::RenderState player;
+    bool thrusting = false;
+
+    bool  game_over     = false;
+    int   collided_tile = 0;
+    float camera_x      = 0.0f;
+
+    // ————— HUD ————— //
+    float fuel         = 0.0f;
+    float altitude     = 0.0f;
+    float clearance    = 0.0f;
+    float speed        = 0.0f;
+    float mission_time = 0.0f;
+    bool  autopilot    = false;
+
+    // What the policy table says to do, when one is loaded and the player is flying
+    bool hint_shown = false;
+    PolicyTable::Entry hint;
+
+    unsigned long step_count = 0;  // fixed steps simulated so far
+};
 
 // ————— VARIABLES ————— //
 GameState g_game_state;
 
 SDL_Window* g_display_window;
+SDL_GLContext g_gl_context = nullptr;
 AppStatus g_app_status = RUNNING;
 
 ShaderProgram g_shader_program;
-glm::mat4 g_view_matrix, g_projection_matrix, g_accomplished_matrix, g_failed_matrix;
+glm::mat4 g_view_matrix, g_projection_matrix;
+Transform2D g_accomplished_transform, g_failed_transform;
+Transform2D g_player_transform;  // main thread's, for drawing the player's snapshot
 
 GLuint g_accomplished_texture_id, g_failed_texture_id;
 
 GLuint g_font_texture_id;
 
+// ————— PARTICLES ————— //
+// Purely visual, so they live on the main thread and are driven from snapshots
+ParticleSystem *g_particles;
+SpriteBatch    *g_particle_batch;
+ShaderProgram   g_particle_program;
+GLuint          g_particle_texture_id;
+float g_exhaust_accumulator = 0.0f;   // fractional particles owed from previous frames
+float g_crash_seconds       = 0.0f;   // time left showing the crash before the end screen
+bool  g_crash_started       = false;
+bool  g_fixed_frame_time    = false;  // headless runs advance particles by FIXED_TIMESTEP
+std::chrono::steady_clock::time_point g_last_particle_update;
+
+// ————— PERFORMANCE HUD ————— //
+PerfHud *g_perf_hud;
+bool     g_perf_hud_requested = false;
+bool     g_frame_clock_reset  = true;   // skip the next frame-time sample (first frame, after idling)
+unsigned long g_rendered_step_count = 0;
+int      g_frame_simulation_steps   = 0;
+std::chrono::steady_clock::time_point g_last_frame_end;
+
+// ————— HUD READOUTS ————— //
+TextLabel *g_fuel_label, *g_altitude_label, *g_velocity_label, *g_timer_label, *g_proximity_label,
+          *g_autopilot_label, *g_hint_label;
+float g_mission_time = 0.0f;
+
+// ————— AUTOPILOT ————— //
+// Flown on the simulation thread; P (or --autopilot) hands it the controls
+Autopilot        *g_autopilot;
+std::atomic<bool> g_autopilot_engaged(false);
+
+// Optional solved landing policy (tools/policy_solver.cpp), for HUD hints and
+// for the autopilot to start from
+const char  *g_policy_path = nullptr;
+PolicyTable *g_policy      = nullptr;
+
 constexpr int NUMBER_OF_TEXTURES = 1;
 constexpr GLint LEVEL_OF_DETAIL  = 0;
 constexpr GLint TEXTURE_BORDER   = 0;
 
+// tools/reachability.cpp checks a copy of this (and the spawn) for pads that
+// can't be reached
 unsigned int LEVEL_1_DATA[] = {
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
     0, 0, 0, 0, 3, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -100,15 +231,60 @@ unsigned int LEVEL_1_DATA[] = {
 float g_previous_ticks = 0.0f,
       g_accumulator    = 0.0f;
 
-bool game_over;
+// ————— SIMULATION THREAD ————— //
+// Only the simulation touches the player and the accumulator once the thread
+// starts; the main thread sees the game through g_snapshots alone.
+TripleBuffer<RenderSnapshot> g_snapshots;
+std::atomic<unsigned> g_input_bits(0);
+std::atomic<bool>     g_simulation_running(false);
+std::atomic<bool>     g_simulation_paused(false);
+std::thread           g_simulation_thread;
+bool                  g_threaded_simulation = true;
+unsigned long         g_step_count = 0;
+
+// ————— FRAME PACING ————— //
+FrameScheduler *g_frame_scheduler;
+bool  g_vsync_requested   = true;
+float g_target_frame_rate = 0.0f;  // 0 = vsync only, or DEFAULT_FRAME_RATE without it
+
+// ————— HEADLESS RUNS ————— //
+#ifdef HEADLESS_EGL
+HeadlessContext *g_headless_context = nullptr;
+int         g_headless_frames = 0;        // > 0 selects a headless run of this many frames
+const char *g_capture_prefix  = nullptr;  // dump frames as <prefix>_NNNN.ppm
+int         g_capture_every   = 1;
+
+// Scripted input for headless runs: each entry holds from its frame onwards
+struct ScriptedInput { int frame; unsigned input; };
+#endif
+
+// ————— ALLOCATION TRACKING ————— //
+bool          g_zero_alloc_requested = false;
+unsigned long g_frames_rendered      = 0;
 
-void draw_text(ShaderProgram *shader_program, GLuint font_texture_id, std::string text,
-               float font_size, float spacing, glm::vec3 position);
+// ————— IDLE DETECTION ————— //
+bool g_needs_redraw   = true;   // set when the window contents may have been lost
+bool g_window_focused = true;
 
 void initialise();
+void initialise_window();
+void initialise_game();
+void handle_event(const SDL_Event &event);
+bool is_idle();
+void wait_while_idle();
 void process_input();
+void apply_input(unsigned input);
+void simulate_step();
+bool is_game_over();
+int  step_simulation(float elapsed);
+float measure_altitude(const Transform &transform, const Collider &collider);
+void publish_snapshot();
+void simulation_loop();
 void update();
+void update_particles(const RenderSnapshot &snapshot);
 void render();
+void present();
+void end_frame();
 void shutdown();
 
 // ———— GENERAL FUNCTIONS ———— //
@@ -125,7 +301,7 @@ GLuint load_texture(const char* filepath)
     
     GLuint texture_id;
     glGenTextures(NUMBER_OF_TEXTURES, &texture_id);
-    glBindTexture(GL_TEXTURE_2D, texture_id);
+    GLState::bind_texture(texture_id);
     glTexImage2D(GL_TEXTURE_2D, LEVEL_OF_DETAIL, GL_RGBA, width, height, TEXTURE_BORDER, GL_RGBA, GL_UNSIGNED_BYTE, image);
     
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -138,83 +314,66 @@ GLuint load_texture(const char* filepath)
     return texture_id;
 }
 
-// taken from lecture: sprites-and-text to draw UI for fuel (Extra - Credit)
-void draw_text(ShaderProgram *shader_program, GLuint font_texture_id, std::string text,
-               float font_size, float spacing, glm::vec3 position)
+// A soft round dot for particles; the tint comes from each instance
+GLuint create_particle_texture()
 {
-    // Scale the size of the fontbank in the UV-plane
-    // We will use this for spacing and positioning
-    float width = 1.0f / FONTBANK_SIZE;
-    float height = 1.0f / FONTBANK_SIZE;
-
-    // Instead of having a single pair of arrays, we'll have a series of pairs—one for
-    // each character. Don't forget to include <vector>!
-    std::vector<float> vertices;
-    std::vector<float> texture_coordinates;
-
-    // For every character...
-    for (int i = 0; i < text.size(); i++) {
-        // 1. Get their index in the spritesheet, as well as their offset (i.e. their
-        //    position relative to the whole sentence)
-        int spritesheet_index = (int) text[i];  // ascii value of character
-        float offset = (font_size + spacing) * i;
-
-        // 2. Using the spritesheet index, we can calculate our U- and V-coordinates
-        float u_coordinate = (float) (spritesheet_index % FONTBANK_SIZE) / FONTBANK_SIZE;
-        float v_coordinate = (float) (spritesheet_index / FONTBANK_SIZE) / FONTBANK_SIZE;
-
-        // 3. Inset the current pair in both vectors
-        vertices.insert(vertices.end(), {
-            offset + (-0.5f * font_size), 0.5f * font_size,
-            offset + (-0.5f * font_size), -0.5f * font_size,
-            offset + (0.5f * font_size), 0.5f * font_size,
-            offset + (0.5f * font_size), -0.5f * font_size,
-            offset + (0.5f * font_size), 0.5f * font_size,
-            offset + (-0.5f * font_size), -0.5f * font_size,
-        });
-
-        texture_coordinates.insert(texture_coordinates.end(), {
-            u_coordinate, v_coordinate,
-            u_coordinate, v_coordinate + height,
-            u_coordinate + width, v_coordinate,
-            u_coordinate + width, v_coordinate + height,
-            u_coordinate + width, v_coordinate,
-            u_coordinate, v_coordinate + height,
-        });
-    }
-
-    // 4. And render all of them using the pairs
-    glm::mat4 model_matrix = glm::mat4(1.0f);
-    model_matrix = glm::translate(model_matrix, position);
-
-    shader_program->set_model_matrix(model_matrix);
-    glUseProgram(shader_program->get_program_id());
+    unsigned char pixels[PARTICLE_TEXTURE_SIZE * PARTICLE_TEXTURE_SIZE * 4];
+    float centre = (PARTICLE_TEXTURE_SIZE - 1) * 0.5f;
 
-    glVertexAttribPointer(shader_program->get_position_attribute(), 2, GL_FLOAT, false, 0,
-                          vertices.data());
-    glEnableVertexAttribArray(shader_program->get_position_attribute());
+    for (int y = 0; y < PARTICLE_TEXTURE_SIZE; y++)
+    {
+        for (int x = 0; x < PARTICLE_TEXTURE_SIZE; x++)
+        {
+            float distance = sqrtf((x - centre) * (x - centre) + (y - centre) * (y - centre)) / centre;
+            float falloff  = distance >= 1.0f ? 0.0f : 1.0f - distance * distance;
+
+            unsigned char *pixel = &pixels[(y * PARTICLE_TEXTURE_SIZE + x) * 4];
+            pixel[0] = pixel[1] = pixel[2] = 255;
+            pixel[3] = (unsigned char) (255.0f * falloff);
+        }
+    }
 
-    glVertexAttribPointer(shader_program->get_tex_coordinate_attribute(), 2, GL_FLOAT,
-                          false, 0, texture_coordinates.data());
-    glEnableVertexAttribArray(shader_program->get_tex_coordinate_attribute());
+    GLuint texture_id;
+    glGenTextures(NUMBER_OF_TEXTURES, &texture_id);
+    GLState::bind_texture(texture_id);
+    glTexImage2D(GL_TEXTURE_2D, LEVEL_OF_DETAIL, GL_RGBA, PARTICLE_TEXTURE_SIZE, PARTICLE_TEXTURE_SIZE,
+                 TEXTURE_BORDER, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 
-    glBindTexture(GL_TEXTURE_2D, font_texture_id);
-    glDrawArrays(GL_TRIANGLES, 0, (int) (text.size() * 6));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-    glDisableVertexAttribArray(shader_program->get_position_attribute());
-    glDisableVertexAttribArray(shader_program->get_tex_coordinate_attribute());
+    return texture_id;
 }
 
 void initialise()
+{
+    initialise_window();
+    initialise_game();
+}
+
+void initialise_window()
 {
     SDL_Init(SDL_INIT_VIDEO);
+
+#ifndef USE_LEGACY_GL
+    // Buffer objects and VAOs only, so ask for a core profile
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+#ifdef __APPLE__
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG);
+#endif
+#endif
+
     g_display_window = SDL_CreateWindow("Lunar Lander Vamp",
                                       SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
                                       WINDOW_WIDTH, WINDOW_HEIGHT,
                                       SDL_WINDOW_OPENGL);
 
-    SDL_GLContext context = SDL_GL_CreateContext(g_display_window);
-    SDL_GL_MakeCurrent(g_display_window, context);
+    g_gl_context = SDL_GL_CreateContext(g_display_window);
+    SDL_GL_MakeCurrent(g_display_window, g_gl_context);
 
     if (g_display_window == nullptr)
     {
@@ -223,9 +382,20 @@ void initialise()
     }
 
 #ifdef _WINDOWS
+    glewExperimental = GL_TRUE;
     glewInit();
 #endif
 
+    // Vsync when the driver allows it; either way never spin the loop uncapped
+    g_frame_scheduler = new FrameScheduler();
+    g_frame_scheduler->set_vsync(g_vsync_requested);
+    if (g_target_frame_rate == 0.0f && !g_frame_scheduler->get_vsync()) g_target_frame_rate = DEFAULT_FRAME_RATE;
+    g_frame_scheduler->set_target_rate(g_target_frame_rate);
+}
+
+// Everything after the GL context exists, whichever way it was created
+void initialise_game()
+{
     glViewport(VIEWPORT_X, VIEWPORT_Y, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
 
     g_shader_program.load(V_SHADER_PATH, F_SHADER_PATH);
@@ -236,224 +406,796 @@ void initialise()
     g_shader_program.set_projection_matrix(g_projection_matrix);
     g_shader_program.set_view_matrix(g_view_matrix);
 
-    glUseProgram(g_shader_program.get_program_id());
+    g_particle_program.load(PARTICLE_V_SHADER_PATH, PARTICLE_F_SHADER_PATH);
+    g_particle_program.set_projection_matrix(g_projection_matrix);
+
+    g_shader_program.use();
 
     glClearColor(BG_RED, BG_BLUE, BG_GREEN, BG_OPACITY);
     
     // MAP SETUP //
     GLuint map_texture_id = load_texture(MAP_TILESET_FILEPATH);
     g_game_state.map = new Map(LEVEL1_WIDTH, LEVEL1_HEIGHT, LEVEL_1_DATA, map_texture_id, 1.0f, TILE_COUNT_X, TILE_COUNT_Y);
+    g_game_state.map->build_distance_fields();
 
     
     // ————— VAMPIRE ————— //
-    std::vector<GLuint> vampire_textures_ids = {
-        load_texture("vamp.png"),   // IDLE spritesheet
-        load_texture("bat.png")  // IDLE spritesheet
-    };
-
-    std::vector<std::vector<int>> vampire_animations = {
-        {0},       // IDLE animation frames
-        {0}  // ATTACK animation frames
-    };
+    Sprite vampire_sprite;
+    vampire_sprite.texture_ids[IDLE]   = load_texture("vamp.png");  // IDLE spritesheet
+    vampire_sprite.texture_ids[ATTACK] = load_texture("bat.png");   // shown while thrusting
     
     // font texture
     g_font_texture_id = load_texture(FONTSHEET_FILEPATH);
+
+    // ————— PARTICLES ————— //
+    g_particles           = new ParticleSystem(ParticleSystem::DEFAULT_CAPACITY);
+    g_particle_batch      = new SpriteBatch(ParticleSystem::DEFAULT_CAPACITY);
+    g_particle_texture_id = create_particle_texture();
+    g_last_particle_update = std::chrono::steady_clock::now();
+
+    g_perf_hud = new PerfHud(g_font_texture_id);
+    g_perf_hud->set_budget(MILLISECONDS_IN_SECOND / (g_target_frame_rate > 0.0f ? g_target_frame_rate : DEFAULT_FRAME_RATE));
+    if (g_perf_hud_requested) g_perf_hud->toggle();
+
+    g_fuel_label     = new TextLabel(g_font_texture_id, 0.5f, 0.05f, glm::vec3(-2.0f, 2.0f, 0.0f));
+    g_altitude_label = new TextLabel(g_font_texture_id, 0.3f, 0.03f, glm::vec3(-4.7f, 2.2f, 0.0f));
+    g_velocity_label = new TextLabel(g_font_texture_id, 0.3f, 0.03f, glm::vec3(-4.7f, 1.85f, 0.0f));
+    g_timer_label    = new TextLabel(g_font_texture_id, 0.3f, 0.03f, glm::vec3(-4.7f, 1.5f, 0.0f));
+    g_proximity_label = new TextLabel(g_font_texture_id, 0.3f, 0.03f, glm::vec3(-4.7f, 1.15f, 0.0f));
+    g_proximity_label->set_text("TERRAIN");
+    g_autopilot_label = new TextLabel(g_font_texture_id, 0.3f, 0.03f, glm::vec3(2.0f, 2.2f, 0.0f));
+    g_autopilot_label->set_text("AUTOPILOT");
+    g_hint_label = new TextLabel(g_font_texture_id, 0.3f, 0.03f, glm::vec3(-4.7f, 0.8f, 0.0f));
     
-    g_game_state.player = new Entity(
-        vampire_textures_ids,  // a list of texture IDs
-        1.0f,                // translation speed; irrelevant in this problem
-        vampire_animations,    // list of animation frames for each type of animation
-        0.0f,                // animation time
-        1,                   // number of frames for idle animation
-        0,                   // current frame index
-        1,                   // current animation col amount
-        1,                   // current animation row amount
-        IDLE                 // current animation
-    );
-
-    g_game_state.player->set_position(PLAYER_IDLE_LOCATION);
-    
-    g_accomplished_matrix = glm::mat4(1.0f);
-    g_accomplished_matrix = glm::scale(g_accomplished_matrix, INIT_FINAL_SCREEN_SCALE);
+    // The player is the only entity: everything that flies, collides and
+    // gets drawn about it is a component
+    g_game_state.world  = new World();
+    g_game_state.player = g_game_state.world->create();
+
+    World    &world  = *g_game_state.world;
+    EntityId  player = g_game_state.player;
+
+    Transform start;
+    start.x = PLAYER_IDLE_LOCATION.x;
+    start.y = PLAYER_IDLE_LOCATION.y;
+
+    world.add<Transform>(player, start);
+    world.add<Velocity>(player);
+    const Collider &collider = world.add<Collider>(player);
+    world.add<Fuel>(player);
+    world.add<Sprite>(player, vampire_sprite);
+
+    g_autopilot = new Autopilot(g_game_state.map, collider.width, collider.height);
+
+    AI pilot;
+    pilot.autopilot = g_autopilot;
+    world.add<AI>(player, pilot);
+
+    if (g_policy_path != nullptr)
+    {
+        g_policy = new PolicyTable();
+        if (g_policy->open(g_policy_path)) {
+            g_autopilot->set_policy(g_policy);
+        } else {
+            std::cerr << "Couldn't load the policy table " << g_policy_path << "\n";
+            delete g_policy;
+            g_policy = nullptr;
+        }
+    }
     
-    g_failed_matrix = glm::mat4(1.0f);
-    g_failed_matrix = glm::scale(g_failed_matrix, INIT_FINAL_SCREEN_SCALE);
+    g_accomplished_transform.set_scale(INIT_FINAL_SCREEN_SCALE.x, INIT_FINAL_SCREEN_SCALE.y);
+    g_failed_transform.set_scale(INIT_FINAL_SCREEN_SCALE.x, INIT_FINAL_SCREEN_SCALE.y);
     
     g_accomplished_texture_id  = load_texture(ACCOMPLISHED_FILEPATH);
     g_failed_texture_id  = load_texture(FAILED_FILEPATH);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::set_blend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // First frame has something to draw before the simulation has stepped
+    publish_snapshot();
+    g_snapshots.update();
+
+    g_previous_ticks = (float) SDL_GetTicks() / MILLISECONDS_IN_SECOND;
+
+    if (g_threaded_simulation)
+    {
+        g_simulation_running = true;
+        g_simulation_thread  = std::thread(simulation_loop);
+    }
+}
 
+void handle_event(const SDL_Event &event)
+{
+    switch (event.type) {
+        case SDL_QUIT:
+            g_app_status = TERMINATED;
+            break;
+
+        case SDL_WINDOWEVENT:
+            switch (event.window.event)
+            {
+                case SDL_WINDOWEVENT_CLOSE:
+                    g_app_status = TERMINATED;
+                    break;
+
+                case SDL_WINDOWEVENT_FOCUS_LOST:
+                    g_window_focused    = false;
+                    g_simulation_paused = true;
+                    break;
+
+                case SDL_WINDOWEVENT_FOCUS_GAINED:
+                    g_window_focused    = true;
+                    g_simulation_paused = false;
+                    g_needs_redraw      = true;
+                    break;
+
+                // The compositor may have thrown our pixels away
+                case SDL_WINDOWEVENT_SHOWN:
+                case SDL_WINDOWEVENT_EXPOSED:
+                case SDL_WINDOWEVENT_RESTORED:
+                    g_needs_redraw = true;
+                    break;
+
+                default:
+                    break;
+            }
+            break;
+
+        case SDL_KEYDOWN:
+            switch (event.key.keysym.sym)
+            {
+                case SDLK_q:
+                    g_app_status = TERMINATED;
+                    break;
+
+                case SDLK_F1:
+                    g_perf_hud->toggle();
+                    g_needs_redraw = true;
+                    break;
+
+                case SDLK_p:
+                    g_autopilot_engaged = !g_autopilot_engaged;
+                    break;
+
+                default:
+                    break;
+            }
+            break;
+
+        default:
+            break;
+    }
 }
 
-void process_input()
+// Nothing on screen can change: the end screen is already up, or the window
+// is in the background (which also pauses the simulation)
+bool is_idle()
 {
-    g_game_state.player->set_animation_state(IDLE);
-    g_game_state.player->set_acceleration(glm::vec3(0.0f));
+    if (!g_window_focused) return true;
+    return g_snapshots.read_buffer().game_over && g_crash_seconds <= 0.0f && !g_needs_redraw;
+}
 
+// Blocks on the event queue instead of rendering identical frames
+void wait_while_idle()
+{
     SDL_Event event;
-    while (SDL_PollEvent(&event))
+    if (SDL_WaitEventTimeout(&event, IDLE_WAIT_MILLISECONDS))
     {
-        switch (event.type) {
-            case SDL_QUIT:
-            case SDL_WINDOWEVENT_CLOSE:
-                g_app_status = TERMINATED;
-                break;
-
-            case SDL_KEYDOWN:
-                switch (event.key.keysym.sym)
-                {
-                    case SDLK_q:
-                        g_app_status = TERMINATED;
-                        break;
-
-                    default:
-                        break;
-                }
-                break;
-
-            default:
-                break;
-        }
+        handle_event(event);
+        while (SDL_PollEvent(&event)) handle_event(event);
     }
 
+    g_frame_clock_reset = true;
+
+    // Don't let the time spent waiting land in the physics accumulator (the
+    // simulation thread resets its own clock when it's unpaused)
+    if (!is_idle() && !g_threaded_simulation)
+    {
+        g_previous_ticks = (float) SDL_GetTicks() / MILLISECONDS_IN_SECOND;
+        g_accumulator    = 0.0f;
+    }
+}
+
+void process_input()
+{
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) handle_event(event);
+
     const Uint8 *key_state = SDL_GetKeyboardState(NULL);
 
-    // Handle rotation
-    if (key_state[SDL_SCANCODE_D]) {
-        g_game_state.player->set_rotation(90.0f); // Rotate to 90 degrees
+    unsigned input = 0;
+    if (key_state[SDL_SCANCODE_SPACE]) input |= INPUT_THRUST;
+    if (key_state[SDL_SCANCODE_D])     input |= INPUT_ROTATE_RIGHT;
+    if (key_state[SDL_SCANCODE_A])     input |= INPUT_ROTATE_LEFT;
+    if (key_state[SDL_SCANCODE_W])     input |= INPUT_ROTATE_UP;
+
+    g_input_bits.store(input, std::memory_order_relaxed);
+}
+
+// ————— SIMULATION ————— //
+void apply_input(unsigned input)
+{
+    World &world = *g_game_state.world;
+    AI    &pilot = *world.get<AI>(g_game_state.player);
+
+    // A/D torque the lander round; W swings it back upright
+    LanderInput requested;
+    if (input & INPUT_ROTATE_RIGHT) requested.torque += 1.0f;
+    if (input & INPUT_ROTATE_LEFT)  requested.torque -= 1.0f;
+    if (requested.torque == 0.0f && (input & INPUT_ROTATE_UP)) {
+        requested.torque = LanderPhysics::levelling_torque(Systems::lander_state(world, g_game_state.player));
     }
-    else if (key_state[SDL_SCANCODE_A]) {
-        g_game_state.player->set_rotation(-90.0f); // Rotate to -90 degrees
+    requested.thrust = (input & INPUT_THRUST) != 0;
+
+    // The pilot system overwrites the keys while the autopilot's engaged
+    pilot.input   = requested;
+    pilot.engaged = g_autopilot_engaged.load(std::memory_order_relaxed);
+}
+
+void simulate_step()
+{
+    World    &world    = *g_game_state.world;
+    Collider &collider = *world.get<Collider>(g_game_state.player);
+
+    apply_input(g_input_bits.load(std::memory_order_relaxed));
+    Systems::step(world, g_game_state.map, FIXED_TIMESTEP);
+    if (!collider.finished) g_mission_time += FIXED_TIMESTEP;
+
+    // Checking if the player has fallen below the threshold
+    if (world.get<Transform>(g_game_state.player)->y < FALL_THRESHOLD)
+    {
+        collider.finished     = true; // End the game if so
+        collider.touched_tile = 2;    // Setting tile to 2 to trigger "Mission Failed"
     }
-    else if (key_state[SDL_SCANCODE_W]) {
-        g_game_state.player->set_rotation(0.0f); // Rotate back to 0 degrees
+
+    g_step_count++;
+}
+
+bool is_game_over()
+{
+    return g_game_state.world->get<Collider>(g_game_state.player)->finished;
+}
+
+// Runs every whole fixed step that `elapsed` (plus the leftover from last
+// time) covers, then publishes the result. Returns the number of steps run.
+int step_simulation(float elapsed)
+{
+    g_accumulator += elapsed;
+
+    int steps = 0;
+    while (g_accumulator >= FIXED_TIMESTEP && !is_game_over())
+    {
+        if (steps == MAX_STEPS_PER_UPDATE)
+        {
+            g_accumulator = 0.0f;
+            break;
+        }
+
+        simulate_step();
+        g_accumulator -= FIXED_TIMESTEP;
+        steps++;
     }
 
-    // Accelerate only if there is fuel
-    if (g_game_state.player->has_fuel() && key_state[SDL_SCANCODE_SPACE]) {
-        g_game_state.player->set_animation_state(ATTACK);
-        g_game_state.player->decrease_fuel(Entity::FUEL_CONSUMPTION_RATE);
+    // Nothing left to simulate once the game is over
+    if (is_game_over()) g_accumulator = 0.0f;
+
+    if (steps > 0) publish_snapshot();
+    return steps;
+}
+
+// Clearance under the lander's feet: straight down to the first solid tile,
+// or to the bottom of the map when there's nothing underneath
+float measure_altitude(const Transform &transform, const Collider &collider)
+{
+    Map *map = g_game_state.map;
+    glm::vec3 feet = glm::vec3(transform.x, transform.y - collider.height / 2.0f, 0.0f);
+
+    Map::RaycastHit ground = map->raycast(feet, glm::vec3(0.0f, -1.0f, 0.0f), ALTIMETER_RANGE);
+    return ground.hit ? ground.distance : feet.y - map->get_bottom_bound();
+}
+
+void publish_snapshot()
+{
+    const World     &world     = *g_game_state.world;
+    EntityId         player    = g_game_state.player;
+    const Transform &transform = *world.get<Transform>(player);
+    const Velocity  &velocity  = *world.get<Velocity>(player);
+    const Collider  &collider  = *world.get<Collider>(player);
+    const Fuel      &fuel      = *world.get<Fuel>(player);
+    RenderSnapshot  &snapshot  = g_snapshots.write_buffer();
+
+    snapshot.player        = Systems::render_state(world, player);
+    snapshot.thrusting     = fuel.burning;
+    snapshot.game_over     = collider.finished;
+    snapshot.collided_tile = collider.touched_tile;
+
+    // Camera follows the player (the end screen draws in UI space regardless)
+    snapshot.camera_x = transform.x;
+
+    snapshot.fuel         = fuel.amount;
+    snapshot.altitude     = measure_altitude(transform, collider);
+    // The field stops at the map's top row, so add however far above it we are
+    float above_map = std::max(0.0f, transform.y - g_game_state.map->get_top_bound());
+    snapshot.clearance    = g_game_state.map->solid_distance(glm::vec3(transform.x, transform.y, 0.0f)) + above_map
+                          - collider.height / 2.0f;
+    snapshot.speed        = sqrtf(velocity.x * velocity.x + velocity.y * velocity.y);
+    snapshot.mission_time = g_mission_time;
+    snapshot.autopilot    = g_autopilot_engaged.load(std::memory_order_relaxed);
+
+    // Hints aim for the pad the autopilot would pick
+    snapshot.hint_shown = false;
+    if (g_policy != nullptr && !snapshot.autopilot)
+    {
+        LanderState lander = Systems::lander_state(world, player);
+        int pad = g_autopilot->best_pad(lander);
+        if (pad >= 0)
+        {
+            const Autopilot::Pad &target = g_autopilot->get_pads()[pad];
+            snapshot.hint       = g_policy->lookup(lander, target.x, target.y);
+            snapshot.hint_shown = true;
+        }
     }
+    snapshot.step_count   = g_step_count;
+
+    g_snapshots.publish();
 }
 
+// Body of the simulation thread: the same fixed-step loop as update(), on its
+// own clock, sleeping until the next step is due
+void simulation_loop()
+{
+    typedef std::chrono::steady_clock Clock;
 
+    const Clock::duration step_duration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(FIXED_TIMESTEP));
+    Clock::time_point previous = Clock::now();
+
+    AllocationTracker::set_phase(AllocationTracker::PHASE_SIMULATION);
+
+    while (g_simulation_running)
+    {
+        if (g_simulation_paused)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_WAIT_MILLISECONDS));
+            previous      = Clock::now();
+            g_accumulator = 0.0f;
+            continue;
+        }
+
+        Clock::time_point now = Clock::now();
+        step_simulation(std::chrono::duration<float>(now - previous).count());
+        previous = now;
+
+        // Wake up roughly when the next whole step has accumulated
+        Clock::duration remaining = step_duration - std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<float>(g_accumulator));
+        std::this_thread::sleep_until(now + remaining);
+    }
+}
+
+// Single-threaded stepping, for --single-thread
 void update()
 {
     float ticks = (float) SDL_GetTicks() / MILLISECONDS_IN_SECOND;
     float delta_time = ticks - g_previous_ticks;
     g_previous_ticks = ticks;
 
-    delta_time += g_accumulator;
-    
-    if (delta_time < FIXED_TIMESTEP)
+    step_simulation(delta_time);
+}
+
+
+// Exhaust while thrusting, a burst of debris when the lander crashes
+void update_particles(const RenderSnapshot &snapshot)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    float delta_time = g_fixed_frame_time ? FIXED_TIMESTEP
+                     : std::chrono::duration<float>(now - g_last_particle_update).count();
+    g_last_particle_update = now;
+    delta_time = std::min(delta_time, MAX_PARTICLE_STEP);
+
+    // Thrust points along the lander's heading (rotation is clockwise from up)
+    float forward_x, forward_y;
+    fast_sincos(glm::radians(snapshot.player.rotation), &forward_x, &forward_y);
+
+    if (snapshot.thrusting && !snapshot.game_over)
     {
-        g_accumulator = delta_time;
-        return;
+        g_exhaust_accumulator += EXHAUST_PER_SECOND * delta_time;
+        int count = (int) g_exhaust_accumulator;
+        g_exhaust_accumulator -= count;
+
+        ParticleSystem::Emitter exhaust;
+        exhaust.x = snapshot.player.x - forward_x * 0.45f;
+        exhaust.y = snapshot.player.y - forward_y * 0.45f;
+        exhaust.position_jitter = 0.08f;
+        exhaust.velocity_x = -forward_x * 3.0f;
+        exhaust.velocity_y = -forward_y * 3.0f;
+        exhaust.velocity_jitter = 0.6f;
+        exhaust.life = 0.5f;  exhaust.life_jitter = 0.2f;
+        exhaust.size = 0.14f;
+        exhaust.red = 1.0f;   exhaust.green = 0.55f; exhaust.blue = 0.15f; exhaust.alpha = 0.9f;
+        g_particles->emit(exhaust, count);
     }
-    
-    while (delta_time >= FIXED_TIMESTEP)
+
+    // Anything but a pad landing is a crash
+    if (snapshot.game_over && !g_crash_started)
     {
-        g_game_state.player->update(FIXED_TIMESTEP, g_game_state.player, NULL, 0, g_game_state.map);
-        delta_time -= FIXED_TIMESTEP;
+        g_crash_started = true;
+
+        if (snapshot.collided_tile != 3)
+        {
+            g_crash_seconds = CRASH_SECONDS;
+
+            ParticleSystem::Emitter debris;
+            debris.x = snapshot.player.x;
+            debris.y = snapshot.player.y;
+            debris.position_jitter = 0.2f;
+            debris.velocity_y = 2.0f;
+            debris.velocity_jitter = 2.5f;
+            debris.life = 1.2f;  debris.life_jitter = 0.3f;
+            debris.size = 0.09f;
+            debris.red = 0.55f;  debris.green = 0.45f; debris.blue = 0.35f;
+            g_particles->emit(debris, CRASH_DEBRIS_COUNT);
+
+            ParticleSystem::Emitter sparks = debris;
+            sparks.velocity_jitter = 4.0f;
+            sparks.life = 0.6f;  sparks.life_jitter = 0.2f;
+            sparks.size = 0.06f;
+            sparks.red = 1.0f;   sparks.green = 0.8f;  sparks.blue = 0.3f;
+            g_particles->emit(sparks, CRASH_SPARK_COUNT);
+        }
     }
-    
-    g_accumulator = delta_time;
 
-    // Y-position threshold for falling off the screen as the lander did not land
-    float fall_threshold = -5.5f;
+    g_particles->update(delta_time);
 
-    // Checking if the player has fallen below the threshold
-    if (g_game_state.player->get_position().y < fall_threshold)
+    if (g_crash_seconds > 0.0f)
     {
-        g_game_state.player->set_game_status(true); // End the game if so
-        g_game_state.player->set_collided_tile(2);  // Setting tile to 2 to trigger "Mission Failed"
-    }
-    
-    g_view_matrix = glm::mat4(1.0f);
-    
-    // Camera follows the player as long as the game is not over
-    if (!g_game_state.player->get_game_status()) {
-        g_view_matrix = glm::translate(g_view_matrix, glm::vec3(-g_game_state.player->get_position().x, 0.0f, 0.0f));
+        g_crash_seconds -= delta_time;
+        if (g_crash_seconds <= 0.0f) g_particles->clear();
     }
 }
 
-
-void draw_object(glm::mat4 &object_g_model_matrix, GLuint &object_texture_id)
+void draw_object(const Transform2D &object_transform, GLuint &object_texture_id)
 {
-    g_shader_program.set_model_matrix(object_g_model_matrix);
-    glBindTexture(GL_TEXTURE_2D, object_texture_id);
-    glDrawArrays(GL_TRIANGLES, 0, 6); // we are now drawing 2 triangles, so use 6, not 3
+    g_shader_program.set_model_transform(object_transform);
+    g_shader_program.reset_texture_rect();
+    GLState::bind_texture(object_texture_id);
+    Mesh::unit_quad()->draw(); // 2 triangles, so 6 vertices
 }
 
 void render()
 {
+    ShaderProgram::begin_frame();
+    GLState::begin_frame();
     glClear(GL_COLOR_BUFFER_BIT);
 
-    float vertices[] = {
-        -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f,
-        -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f
-    };
+    // Pick up whatever the simulation published last; if it hasn't stepped
+    // since the previous frame, this just redraws the same snapshot
+    g_snapshots.update();
+    const RenderSnapshot &snapshot = g_snapshots.read_buffer();
 
-    float texture_coords[] = {
-        0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f,
-        0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f,
-    };
+    g_frame_simulation_steps = (int) (snapshot.step_count - g_rendered_step_count);
+    g_rendered_step_count    = snapshot.step_count;
 
-    glVertexAttribPointer(g_shader_program.get_position_attribute(), 2, GL_FLOAT, false, 0, vertices);
-    glEnableVertexAttribArray(g_shader_program.get_position_attribute());
-    glVertexAttribPointer(g_shader_program.get_tex_coordinate_attribute(), 2, GL_FLOAT, false, 0, texture_coords);
-    glEnableVertexAttribArray(g_shader_program.get_tex_coordinate_attribute());
+    update_particles(snapshot);
 
-    game_over = g_game_state.player->get_game_status();
-    if (!game_over) {
+    // After a crash the world stays up while the debris plays out
+    if (!snapshot.game_over || g_crash_seconds > 0.0f) {
         // Setting view matrix to follow the player
+        g_view_matrix = glm::translate(glm::mat4(1.0f), glm::vec3(-snapshot.camera_x, 0.0f, 0.0f));
         g_shader_program.set_view_matrix(g_view_matrix);
-        g_game_state.player->render(&g_shader_program);
         g_game_state.map->render(&g_shader_program);
 
+        // Every particle in one instanced draw, under the lander so the
+        // exhaust comes out from behind it
+        g_particle_batch->clear();
+        g_particles->fill_batch(*g_particle_batch);
+        g_particle_program.set_view_matrix(g_view_matrix);
+        g_particle_batch->render(&g_particle_program, g_particle_texture_id);
+        g_shader_program.use();
+
+        if (!snapshot.game_over) Systems::draw(&g_shader_program, snapshot.player, g_player_transform);
+
         // Resetting the view matrix for fuel UI to make them fixed on the screen as the player moves
         glm::mat4 ui_view_matrix = glm::mat4(1.0f);
         g_shader_program.set_view_matrix(ui_view_matrix);
 
-        // drawing the word using the font png to write the fuel remaining, middle top location:
-        std::string fuel_text = "Fuel: " + std::to_string(static_cast<int>(g_game_state.player->get_fuel())) + "%";
-        draw_text(&g_shader_program, g_font_texture_id, fuel_text, 0.5f, 0.05f, glm::vec3(-2.0f, 2.0f, 0.0f));
+        // Labels only re-tessellate when the number they show changes
+        g_fuel_label->set_value("Fuel: ", static_cast<int>(snapshot.fuel), "%");
+        g_altitude_label->set_value("Alt: ", static_cast<int>(snapshot.altitude * 10.0f), "");
+        g_velocity_label->set_value("Vel: ", static_cast<int>(snapshot.speed * 100.0f), "");
+        g_timer_label->set_value("Time: ", static_cast<int>(snapshot.mission_time), "s");
+
+        g_fuel_label->render(&g_shader_program);
+        g_altitude_label->render(&g_shader_program);
+        g_velocity_label->render(&g_shader_program);
+        g_timer_label->render(&g_shader_program);
+        if (snapshot.clearance < PROXIMITY_WARNING_DISTANCE) g_proximity_label->render(&g_shader_program);
+        if (snapshot.autopilot) g_autopilot_label->render(&g_shader_program);
+
+        // Burn or coast, and which way to turn (D tips clockwise) to reach the tilt
+        if (snapshot.hint_shown)
+        {
+            static const char *HINTS[2][3] = { { "Hint: COAST <", "Hint: COAST", "Hint: COAST >" },
+                                               { "Hint: BURN <",  "Hint: BURN",  "Hint: BURN >"  } };
+
+            float turn = snapshot.hint.tilt - glm::radians(snapshot.player.rotation);
+            int   side = turn < -0.1f ? 0 : turn > 0.1f ? 2 : 1;
+
+            bool possible = snapshot.hint.landable && snapshot.hint.fuel <= snapshot.fuel;
+            g_hint_label->set_text(possible ? HINTS[snapshot.hint.thrust][side] : "Hint: NO SAFE LANDING");
+            g_hint_label->render(&g_shader_program);
+        }
 
     } else {
         g_view_matrix = glm::mat4(1.0f);
         g_shader_program.set_view_matrix(g_view_matrix);
         
-        if (g_game_state.player->get_collided_tile() == 3) {
-            draw_object(g_accomplished_matrix, g_accomplished_texture_id);  // Mission Accomplished Screen
+        if (snapshot.collided_tile == 3) {
+            draw_object(g_accomplished_transform, g_accomplished_texture_id);  // Mission Accomplished Screen
         } else {
-            draw_object(g_failed_matrix, g_failed_texture_id);  // Mission Failed Screen
+            draw_object(g_failed_transform, g_failed_texture_id);  // Mission Failed Screen
         }
     }
+
+    // Drawn over everything, in UI space
+    if (g_perf_hud->is_visible())
+    {
+        g_shader_program.set_view_matrix(glm::mat4(1.0f));
+        g_perf_hud->render(&g_shader_program);
+    }
+
+    present();
+    g_needs_redraw = false;
+}
+
+void present()
+{
+#ifdef HEADLESS_EGL
+    // Frames stay in the offscreen framebuffer until they're captured
+    if (g_headless_context != nullptr)
+    {
+        g_headless_context->finish();
+        return;
+    }
+#endif
     SDL_GL_SwapWindow(g_display_window);
 }
 
+// Closes the frame's allocation books, arming --zero-alloc once warmed up
+void end_frame()
+{
+    AllocationTracker::set_phase(AllocationTracker::PHASE_OTHER);
+    AllocationTracker::end_frame();
+
+    g_frames_rendered++;
+    if (g_zero_alloc_requested && g_frames_rendered == ZERO_ALLOC_WARMUP_FRAMES)
+    {
+        AllocationTracker::set_zero_alloc(true);
+    }
+
+    // Feed the perf HUD. The GL counters include the HUD's own draws when it's up.
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (!g_frame_clock_reset)
+    {
+        PerfHud::FrameSample sample;
+        sample.milliseconds     = std::chrono::duration<float, std::milli>(now - g_last_frame_end).count();
+        sample.simulation_steps = g_frame_simulation_steps;
+        sample.draw_calls       = GLState::get_frame_stats().draw_calls;
+        sample.texture_binds    = GLState::get_frame_stats().texture_binds;
+        sample.allocations      = AllocationTracker::get_frame_stats().total.allocations;
+        g_perf_hud->record_frame(sample);
+    }
+    g_last_frame_end    = now;
+    g_frame_clock_reset = false;
+}
+
+#ifdef HEADLESS_EGL
+// ————— HEADLESS ————— //
+// A short, fixed flight: fall, burn, tip right and strafe, level out and
+// burn again, then tip left until the fuel or the ground ends it
+const ScriptedInput HEADLESS_SCRIPT[] = {
+    {   0, 0                                  },
+    {  45, INPUT_THRUST                       },
+    {  80, 0                                  },
+    {  95, INPUT_ROTATE_RIGHT | INPUT_THRUST  },
+    { 110, INPUT_THRUST                       },
+    { 135, INPUT_ROTATE_UP                    },
+    { 180, INPUT_ROTATE_UP | INPUT_THRUST     },
+    { 200, INPUT_ROTATE_UP                    },
+    { 240, INPUT_ROTATE_LEFT | INPUT_THRUST   },
+    { 255, INPUT_THRUST                       },
+    { 270, INPUT_ROTATE_UP                    },
+    { 320, INPUT_ROTATE_UP | INPUT_THRUST     },
+    { 340, INPUT_ROTATE_UP                    },
+};
+
+unsigned scripted_input(int frame)
+{
+    unsigned input = 0;
+    for (const ScriptedInput &entry : HEADLESS_SCRIPT)
+    {
+        if (entry.frame > frame) break;
+        input = entry.input;
+    }
+    return input;
+}
+
+// Renders g_headless_frames frames of the scripted flight, one fixed step per
+// frame so every run draws exactly the same images, and reports frame times
+int run_headless()
+{
+    g_headless_context = new HeadlessContext(WINDOW_WIDTH, WINDOW_HEIGHT);
+    if (!g_headless_context->create()) return 1;
+
+    g_threaded_simulation = false;
+    g_fixed_frame_time    = true;
+    initialise_game();
+
+    std::vector<double> frame_milliseconds;
+    frame_milliseconds.reserve(g_headless_frames);
+
+    int draw_calls = 0;
+    char capture_path[512];
+
+    // Autopilot cost per simulated step, when it's flying
+    double autopilot_milliseconds = 0.0, autopilot_worst = 0.0;
+    long   autopilot_steps = 0, autopilot_rollouts = 0;
+
+    for (int frame = 0; frame < g_headless_frames; frame++)
+    {
+        g_input_bits.store(scripted_input(frame), std::memory_order_relaxed);
+
+        AllocationTracker::set_phase(AllocationTracker::PHASE_SIMULATION);
+        if (step_simulation(FIXED_TIMESTEP) > 0 && g_autopilot_engaged)
+        {
+            const Autopilot::Stats &stats = g_autopilot->get_stats();
+            autopilot_milliseconds += stats.milliseconds;
+            autopilot_worst         = std::max(autopilot_worst, (double) stats.milliseconds);
+            autopilot_rollouts     += stats.rollouts;
+            autopilot_steps++;
+        }
+
+        // Timed from the first GL call to the GPU finishing the frame
+        AllocationTracker::set_phase(AllocationTracker::PHASE_RENDER);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        render();
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        frame_milliseconds.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        draw_calls += GLState::get_frame_stats().draw_calls;
+
+        if (g_capture_prefix != nullptr && frame % g_capture_every == 0)
+        {
+            snprintf(capture_path, sizeof(capture_path), "%s_%04d.ppm", g_capture_prefix, frame);
+            g_headless_context->capture(capture_path);
+        }
+
+        end_frame();
+    }
+
+    // ————— REPORT ————— //
+    std::vector<double> sorted = frame_milliseconds;
+    std::sort(sorted.begin(), sorted.end());
+
+    double total = 0.0;
+    for (double milliseconds : sorted) total += milliseconds;
+
+    int count = (int) sorted.size();
+    if (count > 0)
+    {
+        printf("headless: %d frames at %dx%d, %.1f draw calls/frame\n",
+               count, WINDOW_WIDTH, WINDOW_HEIGHT, (double) draw_calls / count);
+        printf("frame ms: mean %.3f  min %.3f  p50 %.3f  p95 %.3f  p99 %.3f  max %.3f\n",
+               total / count, sorted[0], sorted[count / 2],
+               sorted[std::min(count - 1, count * 95 / 100)],
+               sorted[std::min(count - 1, count * 99 / 100)], sorted[count - 1]);
+    }
+
+    if (autopilot_steps > 0)
+    {
+        const Collider &collider = *g_game_state.world->get<Collider>(g_game_state.player);
+        const char *outcome = !collider.finished          ? "still flying"
+                            : collider.touched_tile == 3  ? "landed"
+                            :                               "crashed";
+        printf("autopilot: %s after %.1fs with %.0f fuel left\n", outcome, g_mission_time,
+               g_game_state.world->get<Fuel>(g_game_state.player)->amount);
+        printf("autopilot ms/step: mean %.4f  max %.4f  (%.1f rollouts/step)\n",
+               autopilot_milliseconds / autopilot_steps, autopilot_worst, (double) autopilot_rollouts / autopilot_steps);
+    }
+
+    return 0;
+}
+#endif
+
 
 
 void shutdown()
 {
-    SDL_Quit();
-    delete   g_game_state.player;
+    // The simulation still holds the player and map
+    if (g_simulation_thread.joinable())
+    {
+        g_simulation_running = false;
+        g_simulation_thread.join();
+    }
+
+    delete   g_game_state.world;
     delete   g_game_state.map;
+    delete   g_fuel_label;
+    delete   g_altitude_label;
+    delete   g_velocity_label;
+    delete   g_timer_label;
+    delete   g_proximity_label;
+    delete   g_autopilot_label;
+    delete   g_autopilot;
+    delete   g_hint_label;
+    delete   g_policy;
+    delete   g_perf_hud;
+    delete   g_particles;
+    delete   g_particle_batch;
+    delete   g_frame_scheduler;
+    Mesh::release_shared();
+
+    // Only now the GL objects above are gone can their context go, and SDL
+    // (which owns the window the context was made for) goes last of all
+#ifdef HEADLESS_EGL
+    delete   g_headless_context;
+#endif
+    if (g_gl_context != nullptr) SDL_GL_DeleteContext(g_gl_context);
+    if (g_display_window != nullptr) SDL_DestroyWindow(g_display_window);
+    SDL_Quit();
 }
 
 
 int main(int argc, char* argv[])
 {
     std::cout << "Kinda buggy in identifying tiles to show end screen" << std::endl;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--no-vsync") == 0) g_vsync_requested = false;
+        else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) g_target_frame_rate = (float) atof(argv[++i]);
+        else if (strcmp(argv[i], "--single-thread") == 0) g_threaded_simulation = false;
+        else if (strcmp(argv[i], "--zero-alloc") == 0) g_zero_alloc_requested = true;
+        else if (strcmp(argv[i], "--perf-hud") == 0) g_perf_hud_requested = true;
+        else if (strcmp(argv[i], "--autopilot") == 0) g_autopilot_engaged = true;
+        else if (strcmp(argv[i], "--policy") == 0 && i + 1 < argc) g_policy_path = argv[++i];
+#ifdef HEADLESS_EGL
+        else if (strcmp(argv[i], "--headless") == 0 && i + 1 < argc) g_headless_frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc) g_capture_prefix = argv[++i];
+        else if (strcmp(argv[i], "--capture-every") == 0 && i + 1 < argc) g_capture_every = std::max(1, atoi(argv[++i]));
+#endif
+    }
+
+#ifdef HEADLESS_EGL
+    if (g_headless_frames > 0)
+    {
+        int status = run_headless();
+        shutdown();
+        return status;
+    }
+#endif
+
     initialise();
 
     while (g_app_status == RUNNING)
     {
+        if (is_idle())
+        {
+            wait_while_idle();
+            continue;
+        }
+
+        AllocationTracker::set_phase(AllocationTracker::PHASE_INPUT);
         process_input();
-        update();
+
+        AllocationTracker::set_phase(AllocationTracker::PHASE_SIMULATION);
+        if (!g_threaded_simulation) update();
+
+        AllocationTracker::set_phase(AllocationTracker::PHASE_RENDER);
         render();
+
+        end_frame();
+        g_frame_scheduler->wait_for_next_frame();
     }
 
     shutdown();
@@ -0,0 +1,11 @@
+#version 330 core
+
+uniform sampler2D diffuse;
+in vec2 texCoordVar;
+in vec4 colourVar;
+
+out vec4 fragColor;
+
+void main() {
+    fragColor = texture(diffuse, texCoordVar) * colourVar;
+}
@@ -0,0 +1,10 @@
+#version 330 core
+
+uniform sampler2D diffuse;
+in vec2 texCoordVar;
+
+out vec4 fragColor;
+
+void main() {
+    fragColor = texture(diffuse, texCoordVar);
+}
@@ -0,0 +1,29 @@
+#version 330 core
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+
+// Per-instance: translation, rotation (radians, counter-clockwise), scale, atlas rect, tint
+layout(location = 2) in vec2 instanceOffset;
+layout(location = 3) in float instanceRotation;
+layout(location = 4) in vec2 instanceScale;
+layout(location = 5) in vec4 instanceTexRect;
+layout(location = 6) in vec4 instanceColour;
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+out vec2 texCoordVar;
+out vec4 colourVar;
+
+void main()
+{
+    vec2 scaled = position * instanceScale;
+    float c = cos(instanceRotation);
+    float s = sin(instanceRotation);
+    vec2 world = vec2(c * scaled.x - s * scaled.y, s * scaled.x + c * scaled.y) + instanceOffset;
+
+    texCoordVar = instanceTexRect.xy + texCoord * instanceTexRect.zw;
+    colourVar   = instanceColour;
+    gl_Position = projectionMatrix * viewMatrix * vec4(world, 0.0, 1.0);
+}
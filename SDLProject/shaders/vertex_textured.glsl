@@ -1,15 +1,20 @@
 attribute vec4 position;
 attribute vec2 texCoord;
 
-uniform mat4 modelMatrix;
+// 2D model transform: the columns of a rotation/scale matrix, then a translation
+uniform vec4 modelBasis;
+uniform vec2 modelOffset;
+
 uniform mat4 viewMatrix;
 uniform mat4 projectionMatrix;
+uniform vec4 texRect;
 
 varying vec2 texCoordVar;
 
 void main()
 {
-	vec4 p = viewMatrix * modelMatrix  * position;
-    texCoordVar = texCoord;
+	vec2 world = mat2(modelBasis.xy, modelBasis.zw) * position.xy + modelOffset;
+	vec4 p = viewMatrix * vec4(world, 0.0, 1.0);
+    texCoordVar = texRect.xy + texCoord * texRect.zw;
 	gl_Position = projectionMatrix * p;
 }
\ No newline at end of file
@@ -0,0 +1,22 @@
+#version 330 core
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+
+// 2D model transform: the columns of a rotation/scale matrix, then a translation
+uniform vec4 modelBasis;
+uniform vec2 modelOffset;
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform vec4 texRect;
+
+out vec2 texCoordVar;
+
+void main()
+{
+    vec2 world = mat2(modelBasis.xy, modelBasis.zw) * position + modelOffset;
+    vec4 p = viewMatrix * vec4(world, 0.0, 1.0);
+    texCoordVar = texRect.xy + texCoord * texRect.zw;
+    gl_Position = projectionMatrix * p;
+}
@@ -0,0 +1,87 @@
+/**
+* Regression tests for World's entity handles. Plain asserts, no framework:
+* it prints nothing and exits 0 when everything holds.
+*
+* Build and run from SDLProject/:
+*
+*   c++ -std=c++14 -I. $(sdl2-config --cflags) tests/world_tests.cpp World.cpp -o world_tests && ./world_tests
+**/
+#undef NDEBUG
+#include <cassert>
+#include "World.h"
+
+// ————— STALE HANDLES ————— //
+// A destroyed entity's handle mustn't reach the components of the entity
+// that gets its slot next
+static void stale_remove_leaves_new_owner_alone()
+{
+    World world;
+
+    EntityId old_entity = world.create();
+    world.add<Fuel>(old_entity);
+    world.destroy(old_entity);
+
+    EntityId new_entity = world.create();
+    assert(ComponentPool<Fuel>::index_of(new_entity) == ComponentPool<Fuel>::index_of(old_entity));
+    world.add<Fuel>(new_entity).amount = 42.0f;
+
+    world.remove<Fuel>(old_entity);
+    world.pool<Fuel>().remove(old_entity);
+
+    assert(world.has<Fuel>(new_entity));
+    assert(world.get<Fuel>(new_entity)->amount == 42.0f);
+    assert(world.pool<Fuel>().size() == 1);
+}
+
+static void stale_pool_add_is_taken_over()
+{
+    World world;
+
+    EntityId old_entity = world.create();
+    world.destroy(old_entity);
+    EntityId new_entity = world.create();
+
+    // Straight into the pool, which can't tell the handle is stale...
+    world.pool<Fuel>().add(old_entity, Fuel());
+    assert(!world.has<Fuel>(new_entity));
+
+    // ...but the live handle's add then owns the slot rather than landing on
+    // a component nobody can reach
+    world.add<Fuel>(new_entity).amount = 7.0f;
+    assert(world.has<Fuel>(new_entity));
+    assert(!world.has<Fuel>(old_entity));
+    assert(world.get<Fuel>(new_entity)->amount == 7.0f);
+    assert(world.pool<Fuel>().size() == 1);
+
+    world.remove<Fuel>(new_entity);
+    assert(!world.has<Fuel>(new_entity));
+    assert(world.pool<Fuel>().size() == 0);
+}
+
+// ————— GENERATIONS ————— //
+static void worn_out_slot_is_retired()
+{
+    World world;
+
+    EntityId first = world.create();
+    EntityId entity = first;
+    for (uint32_t lap = 0; lap < LAST_GENERATION; lap++)
+    {
+        world.destroy(entity);
+        entity = world.create();
+        assert(ComponentPool<Fuel>::index_of(entity) == ComponentPool<Fuel>::index_of(first));
+    }
+
+    world.destroy(entity);
+    EntityId next = world.create();
+    assert(ComponentPool<Fuel>::index_of(next) != ComponentPool<Fuel>::index_of(first));
+    assert(!world.is_alive(first));
+}
+
+int main()
+{
+    stale_remove_leaves_new_owner_alone();
+    stale_pool_add_is_taken_over();
+    worn_out_slot_is_retired();
+    return 0;
+}
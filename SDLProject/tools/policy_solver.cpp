@@ -0,0 +1,353 @@
+/**
+* Offline solver for PolicyTable: value iteration over a grid of lander
+* states relative to a pad, finding the landing that burns the least fuel.
+* Every transition is LanderPhysics::integrate at the game's fixed step, with
+* thrust burning fuel exactly as it does in flight.
+*
+* The ground is taken as flat at pad height, so touching down anywhere but
+* the pad (or too fast on it) is a crash; the autopilot still checks its
+* moves against the real map. Values between grid points are multilinear
+* interpolations, and each sweep is split across threads.
+*
+* Build from SDLProject/:
+*
+*   c++ -std=c++14 -O2 -I. tools/policy_solver.cpp LanderPhysics.cpp PolicyTable.cpp -lpthread -o policy_solver
+*
+* Run, then start the game with --policy policy.bin:
+*
+*   ./policy_solver policy.bin [--threads N] [--max-sweeps N] [--tolerance FUEL]
+*                              [--pad-width W] [--touchdown-speed S]
+**/
+#include "PolicyTable.h"
+#include "LanderPhysics.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+typedef PolicyTable::Header Header;
+
+// ————— GRID ————— //
+// Offset and altitude in world units, velocities in units/s, angle in radians
+constexpr int   COUNTS[PolicyTable::AXIS_COUNT]  = {   25,    21,     9,    11,    7 };
+constexpr float MINIMUM[PolicyTable::AXIS_COUNT] = { -6.0f, 0.0f, -1.0f, -1.5f, -0.6f };
+constexpr float STEP[PolicyTable::AXIS_COUNT]    = { 0.5f, 0.25f, 0.25f, 0.25f, 0.2f };
+
+constexpr float PHYSICS_STEP     = 0.0166666f;  // the game's FIXED_TIMESTEP
+constexpr float TIME_COST        = 1.0f;        // fuel-equivalent per second, to break ties
+constexpr float FAIL             = 1.0e6f;      // value of a state with no way down
+constexpr float LANDABLE_LIMIT   = 1.0e3f;      // anything dearer counts as unlandable
+
+struct Settings
+{
+    const char *path           = nullptr;
+    int   threads              = (int) std::max(1u, std::thread::hardware_concurrency());
+    int   max_sweeps           = 400;
+    float tolerance            = 0.05f;
+    float pad_half_width       = 0.5f;
+    float lander_half_height   = 0.5f;
+    float touchdown_speed      = 0.5f;
+    int   decision_steps       = 24;  // physics steps an action is held for
+};
+
+// Where one action from one state leads. Transitions never change between
+// sweeps, so they're simulated once up front; a sweep is then nothing but
+// interpolation. Successors are stored as the grid cell below them plus how
+// far along each axis they sit, in 1/65535ths.
+struct Transition
+{
+    enum Outcome : uint8_t { CONTINUES, LANDED, CRASHED };
+
+    uint32_t base;
+    uint16_t fraction[PolicyTable::AXIS_COUNT];
+    uint8_t  outcome;
+    uint8_t  steps;   // physics steps until it ended (or decision_steps)
+    float    burned;  // fuel spent on the way
+};
+
+struct Solver
+{
+    Header   header;
+    uint32_t strides[PolicyTable::AXIS_COUNT];
+    uint32_t corner_offsets[1 << PolicyTable::AXIS_COUNT];  // from a cell to each corner of its box
+    uint32_t cell_count;
+    int      action_count;
+    Settings settings;
+
+    std::vector<Transition> transitions;      // cell_count * action_count
+    std::vector<float>      value, next_value;  // fuel plus time cost
+    std::vector<float>      fuel,  next_fuel;   // fuel alone, under the current policy
+    std::vector<uint16_t>   cells;
+
+    void coordinates(uint32_t index, float *out) const
+    {
+        for (int axis = 0; axis < PolicyTable::AXIS_COUNT; axis++)
+        {
+            out[axis] = header.minimum[axis] + (float) ((index / strides[axis]) % header.counts[axis]) * header.step[axis];
+        }
+    }
+
+    // Holds one action for a decision step from a grid state
+    Transition simulate(const float *start, int action) const
+    {
+        LanderState state;
+        state.x          = start[PolicyTable::OFFSET_X];
+        state.y          = start[PolicyTable::ALTITUDE] + settings.lander_half_height;
+        state.velocity_x = start[PolicyTable::VELOCITY_X];
+        state.velocity_y = start[PolicyTable::VELOCITY_Y];
+        state.angle      = start[PolicyTable::ANGLE];
+        state.fuel       = FAIL;  // never runs dry here; what it burns is counted below
+
+        PolicyTable::Entry entry;
+        entry.tilt   = PolicyTable::tilt_for(header, action);
+        entry.thrust = (action & 1) != 0;
+
+        Transition transition;
+        memset(&transition, 0, sizeof(transition));
+
+        const float limit = -header.minimum[PolicyTable::OFFSET_X];
+        for (int step = 1; step <= settings.decision_steps; step++)
+        {
+            LanderPhysics::integrate(state, PolicyTable::to_input(entry, state), PHYSICS_STEP);
+            if (entry.thrust) transition.burned += LanderPhysics::FUEL_BURN_RATE * PHYSICS_STEP;
+            transition.steps = (uint8_t) step;
+
+            if (state.y - settings.lander_half_height <= 0.0f)
+            {
+                bool landed = fabsf(state.x) <= settings.pad_half_width &&
+                              state.velocity_y >= -settings.touchdown_speed &&
+                              fabsf(state.velocity_x) <= settings.touchdown_speed;
+                transition.outcome = landed ? Transition::LANDED : Transition::CRASHED;
+                return transition;
+            }
+            if (state.x < -limit || state.x > limit)
+            {
+                transition.outcome = Transition::CRASHED;
+                return transition;
+            }
+        }
+
+        // Clamped onto the grid everywhere but the two hard edges handled above
+        const float point[PolicyTable::AXIS_COUNT] = {
+            state.x, state.y - settings.lander_half_height, state.velocity_x, state.velocity_y, state.angle
+        };
+        for (int axis = 0; axis < PolicyTable::AXIS_COUNT; axis++)
+        {
+            int   last = (int) header.counts[axis] - 1;
+            float cell = std::max(0.0f, std::min((float) last, (point[axis] - header.minimum[axis]) / header.step[axis]));
+            int   low  = std::min((int) cell, std::max(last - 1, 0));
+
+            transition.base += (uint32_t) low * strides[axis];
+            transition.fraction[axis] = (uint16_t) (std::min(1.0f, cell - (float) low) * 65535.0f + 0.5f);
+        }
+        transition.outcome = Transition::CONTINUES;
+        return transition;
+    }
+
+    void build_transitions(uint32_t first, uint32_t last)
+    {
+        float start[PolicyTable::AXIS_COUNT];
+        for (uint32_t index = first; index < last; index++)
+        {
+            coordinates(index, start);
+            for (int action = 0; action < action_count; action++)
+            {
+                transitions[(size_t) index * action_count + action] = simulate(start, action);
+            }
+        }
+    }
+
+    // Multilinear over all five axes: fetch the 32 corners, then fold them
+    // in half one axis at a time
+    float interpolate(const std::vector<float> &field, const Transition &transition) const
+    {
+        constexpr int CORNERS = 1 << PolicyTable::AXIS_COUNT;
+
+        float corners[CORNERS];
+        for (int corner = 0; corner < CORNERS; corner++) corners[corner] = field[transition.base + corner_offsets[corner]];
+
+        for (int axis = 0, count = CORNERS / 2; axis < PolicyTable::AXIS_COUNT; axis++, count /= 2)
+        {
+            float t = transition.fraction[axis] * (1.0f / 65535.0f);
+            for (int i = 0; i < count; i++) corners[i] = corners[2 * i] + (corners[2 * i + 1] - corners[2 * i]) * t;
+        }
+        return corners[0];
+    }
+
+    float cost(const Transition &transition) const
+    {
+        return transition.burned + TIME_COST * PHYSICS_STEP * transition.steps;
+    }
+
+    // One Jacobi sweep over [first, last); returns the largest change
+    float sweep(uint32_t first, uint32_t last)
+    {
+        float largest_change = 0.0f;
+
+        for (uint32_t index = first; index < last; index++)
+        {
+            const Transition *options = &transitions[(size_t) index * action_count];
+
+            float best = FAIL;
+            int   best_action = -1;
+            for (int action = 0; action < action_count; action++)
+            {
+                const Transition &transition = options[action];
+                float path = transition.outcome == Transition::LANDED  ? cost(transition)
+                           : transition.outcome == Transition::CRASHED ? FAIL
+                           : cost(transition) + interpolate(value, transition);
+                if (path < best)
+                {
+                    best        = path;
+                    best_action = action;
+                }
+            }
+
+            // Fuel is only followed along the chosen action
+            float best_fuel = FAIL;
+            if (best_action < 0) best_action = (int) (header.counts[PolicyTable::ANGLE] / 2) * 2;  // upright, coasting
+            else if (options[best_action].outcome == Transition::LANDED) best_fuel = options[best_action].burned;
+            else best_fuel = options[best_action].burned + interpolate(fuel, options[best_action]);
+
+            next_value[index] = best;
+            next_fuel[index]  = best_fuel;
+            cells[index]      = PolicyTable::pack(best_action, best_fuel, best < LANDABLE_LIMIT);
+
+            // Past the limit, values only matter relative to their size (float
+            // steps up there are bigger than the tolerance)
+            float change = fabsf(best - value[index]);
+            if (best >= LANDABLE_LIMIT) change *= LANDABLE_LIMIT / best;
+            largest_change = std::max(largest_change, change);
+        }
+        return largest_change;
+    }
+};
+
+// Splits [0, count) across the threads and waits for them all
+template <typename Work>
+static void parallel_for(int threads, uint32_t count, Work work)
+{
+    std::vector<std::thread> workers;
+    uint32_t chunk = (count + threads - 1) / threads;
+    for (int t = 0; t < threads; t++)
+    {
+        uint32_t first = std::min(count, chunk * t);
+        uint32_t last  = std::min(count, first + chunk);
+        workers.push_back(std::thread(work, t, first, last));
+    }
+    for (std::thread &worker : workers) worker.join();
+}
+
+static void usage()
+{
+    fprintf(stderr, "usage: policy_solver OUTPUT [--threads N] [--max-sweeps N] [--tolerance FUEL]\n"
+                    "                            [--pad-width W] [--touchdown-speed S]\n");
+}
+
+int main(int argc, char *argv[])
+{
+    Settings settings;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) settings.threads = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--max-sweeps") == 0 && i + 1 < argc) settings.max_sweeps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) settings.tolerance = (float) atof(argv[++i]);
+        else if (strcmp(argv[i], "--pad-width") == 0 && i + 1 < argc) settings.pad_half_width = (float) atof(argv[++i]) / 2.0f;
+        else if (strcmp(argv[i], "--touchdown-speed") == 0 && i + 1 < argc) settings.touchdown_speed = (float) atof(argv[++i]);
+        else if (strcmp(argv[i], "--decision-steps") == 0 && i + 1 < argc) settings.decision_steps = std::max(1, std::min(255, atoi(argv[++i])));
+        else if (argv[i][0] != '-' && settings.path == nullptr) settings.path = argv[i];
+        else { usage(); return 1; }
+    }
+    if (settings.path == nullptr) { usage(); return 1; }
+
+    Solver solver;
+    solver.settings = settings;
+
+    Header &header = solver.header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PolicyTable::MAGIC, sizeof(header.magic));
+    header.version             = PolicyTable::VERSION;
+    header.header_size         = sizeof(Header);
+    header.decision_seconds    = PHYSICS_STEP * settings.decision_steps;
+    header.pad_half_width      = settings.pad_half_width;
+    header.lander_half_height  = settings.lander_half_height;
+    header.max_touchdown_speed = settings.touchdown_speed;
+
+    uint32_t stride = 1;
+    for (int axis = 0; axis < PolicyTable::AXIS_COUNT; axis++)
+    {
+        header.counts[axis]  = COUNTS[axis];
+        header.minimum[axis] = MINIMUM[axis];
+        header.step[axis]    = STEP[axis];
+        solver.strides[axis] = stride;
+        stride *= COUNTS[axis];
+    }
+
+    solver.cell_count   = PolicyTable::cell_count(header);
+    solver.action_count = (int) header.counts[PolicyTable::ANGLE] * 2;
+    for (int corner = 0; corner < (1 << PolicyTable::AXIS_COUNT); corner++)
+    {
+        solver.corner_offsets[corner] = 0;
+        for (int axis = 0; axis < PolicyTable::AXIS_COUNT; axis++)
+        {
+            // An axis with one cell has nowhere to step up to
+            if (((corner >> axis) & 1) && header.counts[axis] > 1) solver.corner_offsets[corner] += solver.strides[axis];
+        }
+    }
+
+    solver.transitions.resize((size_t) solver.cell_count * solver.action_count);
+    solver.value.assign(solver.cell_count, FAIL);
+    solver.fuel.assign(solver.cell_count, FAIL);
+    solver.next_value.resize(solver.cell_count);
+    solver.next_fuel.resize(solver.cell_count);
+    solver.cells.resize(solver.cell_count);
+
+    printf("policy_solver: %u states x %d actions on %d threads (%.0f MB of transitions)\n",
+           solver.cell_count, solver.action_count, settings.threads,
+           solver.transitions.size() * sizeof(Transition) / (1024.0 * 1024.0));
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+
+    parallel_for(settings.threads, solver.cell_count, [&solver](int, uint32_t first, uint32_t last) {
+        solver.build_transitions(first, last);
+    });
+
+    // ————— VALUE ITERATION ————— //
+    std::vector<float> changes(settings.threads);
+
+    int sweep = 0;
+    while (sweep < settings.max_sweeps)
+    {
+        parallel_for(settings.threads, solver.cell_count, [&solver, &changes](int t, uint32_t first, uint32_t last) {
+            changes[t] = solver.sweep(first, last);
+        });
+        solver.value.swap(solver.next_value);
+        solver.fuel.swap(solver.next_fuel);
+        sweep++;
+
+        float change = *std::max_element(changes.begin(), changes.end());
+        if (sweep % 25 == 0) printf("  sweep %d: largest change %.3f\n", sweep, change);
+        if (change < settings.tolerance) break;
+    }
+
+    float seconds = std::chrono::duration<float>(Clock::now() - start).count();
+
+    uint32_t landable = 0;
+    for (float value : solver.value) if (value < LANDABLE_LIMIT) landable++;
+
+    printf("%d sweeps in %.1fs; %.1f%% of states can land\n",
+           sweep, seconds, 100.0f * landable / solver.cell_count);
+
+    if (!PolicyTable::write(settings.path, header, solver.cells.data()))
+    {
+        fprintf(stderr, "policy_solver: couldn't write %s\n", settings.path);
+        return 1;
+    }
+    printf("wrote %s (%zu bytes)\n", settings.path, sizeof(Header) + solver.cells.size() * sizeof(uint16_t));
+    return 0;
+}
@@ -0,0 +1,835 @@
+/**
+* Reachability analyser: finds which landing pads a level's spawn can
+* actually get to, without anyone having to play it.
+*
+* Starting from the spawn, it explores every state the lander can reach
+* breadth-first. A state is its position, velocity, tilt and fuel on a
+* coarse grid. Each move holds one of a few tilts, with thrust on or off, for
+* a fraction of a second. The moves go through LanderPhysics::integrate at the
+* game's fixed step and are checked against the real Map, so touching a pad
+* lands and touching anything else crashes, just as in the game. Each level
+* of the search is expanded across threads, with states deduplicated through
+* a lock-free hash set.
+*
+* Having more fuel never hurts, so the set is keyed on position, velocity and
+* tilt alone and keeps the most fuel each cell has been reached with. A cell
+* is only explored again when a new way in arrives with at least a fuel step
+* more. This keeps the search about as small as if fuel were ignored, while
+* the fuel figures still come out right.
+*
+* It reports, for every run of pad tiles, whether it can be reached and the
+* least fuel that gets there. It also writes a heatmap of where the lander
+* can still land from: green where it always can, red where every way of
+* getting there is already doomed to crash.
+*
+* Build from SDLProject/:
+*
+*   c++ -std=c++14 -O2 -I. $(sdl2-config --cflags) tools/reachability.cpp LanderPhysics.cpp Map.cpp \
+*       DistanceField.cpp OccupancyPyramid.cpp Mesh.cpp GLState.cpp ShaderProgram.cpp AllocationTracker.cpp \
+*       -lpthread $(sdl2-config --libs) -lGL -o reachability
+*
+* (on macOS swap -lGL for -framework OpenGL)
+*
+* Run:
+*
+*   ./reachability [--level FILE] [--spawn X Y] [--fuel F] [--touchdown-speed S]
+*                  [--heatmap FILE] [--scale PIXELS] [--threads N] [--max-states N]
+*
+* Without --level it checks the game's level 1. A level file is the tile
+* numbers row by row, top row first, as in main.cpp's LEVEL_1_DATA.
+**/
+#define GL_SILENCE_DEPRECATION
+#define GL_GLEXT_PROTOTYPES 1
+
+#include "Map.h"
+#include "LanderPhysics.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// ————— LEVEL ————— //
+// The game's level 1 and spawn; keep in step with main.cpp
+constexpr int LEVEL_1_WIDTH  = 20;
+constexpr int LEVEL_1_HEIGHT = 7;
+const unsigned int LEVEL_1_DATA[LEVEL_1_WIDTH * LEVEL_1_HEIGHT] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 3, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 3, 0, 3, 0, 0, 0, 0,
+    0, 0, 0, 2, 1, 1, 3, 0, 1, 1, 0, 3, 2, 1, 2, 1, 1, 1, 0, 3,
+    2, 1, 1, 1, 1, 1, 1, 0, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
+};
+
+constexpr float SPAWN_X        = 3.0f;     // PLAYER_IDLE_LOCATION
+constexpr float SPAWN_Y        = 2.0f;
+constexpr float STARTING_FUEL  = 500.0f;   // Fuel::amount
+constexpr float FALL_THRESHOLD = -5.5f;
+constexpr float PHYSICS_STEP   = 0.0166666f;  // the game's FIXED_TIMESTEP
+constexpr float LANDER_SIZE    = 1.0f;
+
+// ————— SEARCH GRID ————— //
+// States closer than one step apart on every axis count as the same state.
+// Fuel steps only decide when a cell is worth exploring again.
+constexpr float POSITION_STEP = 0.25f;  // world units
+constexpr float VELOCITY_STEP = 0.2f;   // units/s
+constexpr float ANGLE_STEP    = 0.15f;  // radians
+constexpr float FUEL_STEP     = 20.0f;
+constexpr float MAX_SPEED     = 4.0f;   // faster than this on either axis is out of the search
+constexpr float MAX_ANGLE     = 0.9f;   // tilts past this share the last cell
+constexpr float MARGIN        = 2.0f;   // how far past the map's sides (and above the spawn) to follow it
+
+// A move: hold one of these tilts, the way W levels the lander, thrusting or not
+constexpr float TILTS[]        = { -0.6f, -0.3f, 0.0f, 0.3f, 0.6f };
+constexpr int   TILT_COUNT     = sizeof(TILTS) / sizeof(TILTS[0]);
+constexpr int   ACTION_COUNT   = TILT_COUNT * 2;
+constexpr int   DECISION_STEPS = 24;  // physics steps a move is held for
+
+constexpr uint32_t NONE = 0xFFFFFFFF;
+
+struct Settings
+{
+    const char *level_path   = nullptr;
+    const char *heatmap_path = "reachability.ppm";
+    float spawn_x            = SPAWN_X;
+    float spawn_y            = SPAWN_Y;
+    float fuel               = STARTING_FUEL;
+    float touchdown_speed    = INFINITY;  // the game lands at any speed
+    int   scale              = 8;         // heatmap pixels per grid cell
+    int   threads            = (int) std::max(1u, std::thread::hardware_concurrency());
+    uint32_t max_states      = 1u << 22;
+};
+
+// ————— CONCURRENT STATE SET ————— //
+// Open addressing with linear probing over a fixed number of slots. Threads
+// insert by compare-and-swapping a key into an empty slot, so there are no
+// locks anywhere and a slot never moves once taken.
+//
+// Every move into a cell makes it an offer: the fuel it arrived with, then
+// which state and move it came from. The best offer wins: the most fuel, and
+// between equals the earliest parent. That way the results don't depend on
+// thread timing.
+class StateSet
+{
+public:
+    static constexpr uint64_t EMPTY = ~0ull;
+
+    static uint64_t make_offer(int fuel, uint32_t parent, int action)
+    {
+        uint64_t origin = ((uint64_t) parent << 8) | (uint64_t) action;
+        return ((uint64_t) fuel << 40) | (ORIGIN_MASK - origin);
+    }
+    static int      offer_fuel(uint64_t offer)   { return (int) (offer >> 40); }
+    static uint32_t offer_parent(uint64_t offer) { return (uint32_t) ((ORIGIN_MASK - (offer & ORIGIN_MASK)) >> 8); }
+    static int      offer_action(uint64_t offer) { return (int) ((ORIGIN_MASK - (offer & ORIGIN_MASK)) & 0xFF); }
+
+private:
+    static constexpr uint64_t ORIGIN_MASK = (1ull << 40) - 1;
+
+    struct Slot
+    {
+        std::atomic<uint64_t> key;
+        std::atomic<uint64_t> offer;
+        std::atomic<bool>     queued;  // already waiting to be explored next level
+
+        // Only touched between levels
+        int      explored_fuel;  // fuel step it was last explored with, or -1
+        uint32_t index;          // the state it was last explored as, or NONE
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    uint64_t m_mask;
+
+    static uint64_t hash(uint64_t key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdull;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ull;
+        return key ^ (key >> 33);
+    }
+
+public:
+    // Room for at least `capacity` keys at no more than half full
+    explicit StateSet(uint32_t capacity)
+    {
+        uint64_t slots = 1;
+        while (slots < 2ull * capacity) slots <<= 1;
+
+        m_slots.reset(new Slot[slots]);
+        m_mask = slots - 1;
+        for (uint64_t i = 0; i < slots; i++)
+        {
+            m_slots[i].key.store(EMPTY, std::memory_order_relaxed);
+            m_slots[i].offer.store(0, std::memory_order_relaxed);
+            m_slots[i].queued.store(false, std::memory_order_relaxed);
+            m_slots[i].explored_fuel = -1;
+            m_slots[i].index = NONE;
+        }
+    }
+
+    // The slot holding `key`, taking an empty one if it's not there yet.
+    // NONE once the set is full.
+    uint32_t insert(uint64_t key)
+    {
+        for (uint64_t probe = hash(key), tries = 0; tries <= m_mask; probe++, tries++)
+        {
+            Slot &slot = m_slots[probe & m_mask];
+
+            uint64_t found = slot.key.load(std::memory_order_acquire);
+            if (found == EMPTY && slot.key.compare_exchange_strong(found, key, std::memory_order_acq_rel))
+            {
+                return (uint32_t) (probe & m_mask);
+            }
+            // Lost any race above: `found` is now the winner's key, maybe this one
+            if (found == key) return (uint32_t) (probe & m_mask);
+        }
+        return NONE;
+    }
+
+    // Returns true to exactly one caller per level whose offer beats the
+    // fuel the slot was explored with, which should queue it
+    bool offer(uint32_t slot, uint64_t offer)
+    {
+        Slot &target = m_slots[slot];
+
+        uint64_t current = target.offer.load(std::memory_order_relaxed);
+        while (offer > current && !target.offer.compare_exchange_weak(current, offer, std::memory_order_relaxed)) { }
+
+        if (offer_fuel(offer) <= target.explored_fuel) return false;
+        return !target.queued.exchange(true, std::memory_order_relaxed);
+    }
+
+    // Between levels: takes the winning offer and notes it's being explored
+    uint64_t dequeue(uint32_t slot, uint32_t index)
+    {
+        Slot &target = m_slots[slot];
+        uint64_t offer = target.offer.load(std::memory_order_relaxed);
+
+        target.queued.store(false, std::memory_order_relaxed);
+        target.explored_fuel = offer_fuel(offer);
+        target.index         = index;
+        return offer;
+    }
+
+    uint64_t get_offer(uint32_t slot) const { return m_slots[slot].offer.load(std::memory_order_relaxed); }
+    uint32_t get_index(uint32_t slot) const { return m_slots[slot].index; }
+};
+
+constexpr uint64_t StateSet::ORIGIN_MASK;
+
+// ————— PADS ————— //
+// A run of landing pad tiles side by side in one row, and the best any
+// landing on it managed
+struct Pad
+{
+    int tile_x, tile_y, tile_count;
+
+    std::atomic<uint32_t> most_fuel_left;   // float bits; non-negative floats order like their bits
+    std::atomic<uint32_t> earliest_step;    // physics steps from the spawn
+
+    Pad(int x, int y, int count) : tile_x(x), tile_y(y), tile_count(count), most_fuel_left(0), earliest_step(NONE) { }
+
+    bool reached() const { return earliest_step.load() != NONE; }
+};
+
+static void atomic_max(std::atomic<uint32_t> &target, uint32_t value)
+{
+    uint32_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) { }
+}
+
+static void atomic_min(std::atomic<uint32_t> &target, uint32_t value)
+{
+    uint32_t current = target.load(std::memory_order_relaxed);
+    while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) { }
+}
+
+static uint32_t float_bits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float bits_float(uint32_t bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// ————— ANALYSER ————— //
+struct Analyser
+{
+    const Map *map;
+    Settings   settings;
+    std::vector<Pad*> pads;
+    std::vector<int>  pad_of_tile;  // tile index -> pad, or -1
+
+    // The search box, in world units, and how many cells it has per axis
+    float min_x, min_y;
+    int   cells_x, cells_y, cells_velocity, cells_angle;
+
+    // One entry per state explored, in the order explored: the exact state
+    // whose offer won its cell, which is where its moves start from. A cell
+    // reached again with more fuel gets a new entry.
+    std::vector<LanderState> states;
+    std::vector<uint32_t>    cells;        // the slot of each one's cell
+    std::vector<uint32_t>    depths;       // moves from the spawn
+    std::vector<uint32_t>    successors;   // ACTION_COUNT per state: slot during the search, index after, or NONE
+    std::vector<float>       land_now;     // most fuel left after landing with one move, or -1
+
+    struct Outcome
+    {
+        enum Kind { CONTINUES, LANDED, CRASHED } kind;
+        int   pad;
+        int   steps;
+    };
+
+    // ————— SETUP ————— //
+    void find_pads()
+    {
+        int width = map->get_width(), height = map->get_height();
+        pad_of_tile.assign(width * height, -1);
+
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                if (map->get_tile_type(x, y) != (int) Map::LANDING_PAD_TILE) continue;
+
+                if (x > 0 && pad_of_tile[y * width + x - 1] >= 0)
+                {
+                    int pad = pad_of_tile[y * width + x - 1];
+                    pads[pad]->tile_count++;
+                    pad_of_tile[y * width + x] = pad;
+                }
+                else
+                {
+                    pad_of_tile[y * width + x] = (int) pads.size();
+                    pads.push_back(new Pad(x, y, 1));
+                }
+            }
+        }
+    }
+
+    void size_grid()
+    {
+        float tile_size = map->get_tile_size();
+        min_x = -MARGIN;
+        min_y = -map->get_height() * tile_size;
+
+        float max_x = map->get_width() * tile_size + MARGIN;
+        float max_y = std::max(0.0f, settings.spawn_y) + MARGIN;
+
+        cells_x        = (int) ceilf((max_x - min_x) / POSITION_STEP);
+        cells_y        = (int) ceilf((max_y - min_y) / POSITION_STEP);
+        cells_velocity = (int) ceilf(2.0f * MAX_SPEED / VELOCITY_STEP);
+        cells_angle    = (int) ceilf(2.0f * MAX_ANGLE / ANGLE_STEP);
+    }
+
+    // ————— MOVES ————— //
+    // What the lander touches, probing the middle of each side like the
+    // autopilot does: the tile type, and which pad if it's one
+    int touching(const LanderState &state, int *pad) const
+    {
+        float inverse_tile_size = 1.0f / map->get_tile_size();
+        float half = LANDER_SIZE / 2.0f;
+        const float xs[4] = { state.x, state.x - half, state.x + half, state.x };
+        const float ys[4] = { state.y - half, state.y, state.y, state.y + half };
+
+        for (int i = 0; i < 4; i++)
+        {
+            int tile_x = (int) floorf(xs[i] * inverse_tile_size);
+            int tile_y = (int) floorf(-ys[i] * inverse_tile_size);
+            int tile   = map->get_tile_type(tile_x, tile_y);
+            if (tile > 0)
+            {
+                *pad = tile == (int) Map::LANDING_PAD_TILE ? pad_of_tile[tile_y * map->get_width() + tile_x] : -1;
+                return tile;
+            }
+        }
+        return 0;
+    }
+
+    Outcome move(LanderState &state, int action) const
+    {
+        float tilt   = TILTS[action / 2];
+        bool  thrust = (action & 1) != 0;
+
+        Outcome outcome = { Outcome::CONTINUES, -1, DECISION_STEPS };
+        for (int step = 1; step <= DECISION_STEPS; step++)
+        {
+            LanderState relative = state;
+            relative.angle = LanderPhysics::wrap_angle(state.angle - tilt);
+
+            LanderInput input;
+            input.torque = LanderPhysics::levelling_torque(relative);
+            input.thrust = thrust;
+            LanderPhysics::integrate(state, input, PHYSICS_STEP);
+
+            int pad  = -1;
+            int tile = touching(state, &pad);
+            if (tile > 0 || state.y < FALL_THRESHOLD)
+            {
+                bool gentle = fabsf(state.velocity_x) <= settings.touchdown_speed &&
+                              fabsf(state.velocity_y) <= settings.touchdown_speed;
+                outcome.kind  = pad >= 0 && gentle ? Outcome::LANDED : Outcome::CRASHED;
+                outcome.pad   = pad;
+                outcome.steps = step;
+                return outcome;
+            }
+        }
+        return outcome;
+    }
+
+    static int cell(float value, float minimum, float step) { return (int) floorf((value - minimum) / step); }
+
+    static int fuel_step(const LanderState &state) { return std::max(0, cell(state.fuel, 0.0f, FUEL_STEP)); }
+
+    // The grid cell a state falls in, fuel aside, packed into one key; EMPTY
+    // when it's left the search box
+    uint64_t key(const LanderState &state) const
+    {
+        int x          = cell(state.x, min_x, POSITION_STEP);
+        int y          = cell(state.y, min_y, POSITION_STEP);
+        int velocity_x = cell(state.velocity_x, -MAX_SPEED, VELOCITY_STEP);
+        int velocity_y = cell(state.velocity_y, -MAX_SPEED, VELOCITY_STEP);
+        int angle      = std::max(0, std::min(cells_angle - 1, cell(state.angle, -MAX_ANGLE, ANGLE_STEP)));
+
+        if (x < 0 || x >= cells_x || y < 0 || y >= cells_y) return StateSet::EMPTY;
+        if (velocity_x < 0 || velocity_x >= cells_velocity || velocity_y < 0 || velocity_y >= cells_velocity)
+        {
+            return StateSet::EMPTY;
+        }
+
+        uint64_t packed = (uint64_t) x;
+        packed = packed * cells_y        + (uint64_t) y;
+        packed = packed * cells_velocity + (uint64_t) velocity_x;
+        packed = packed * cells_velocity + (uint64_t) velocity_y;
+        packed = packed * cells_angle    + (uint64_t) angle;
+        return packed;
+    }
+
+    // ————— SEARCH ————— //
+    // Tries every move from states [first, last), noting landings and
+    // offering where the others end up. Slots this thread queued go in `found`.
+    void expand(StateSet &set, uint32_t first, uint32_t last, std::vector<uint32_t> &found, bool *full)
+    {
+        for (uint32_t index = first; index < last; index++)
+        {
+            float best_landing = -1.0f;
+
+            for (int action = 0; action < ACTION_COUNT; action++)
+            {
+                uint32_t &successor = successors[(size_t) index * ACTION_COUNT + action];
+                successor = NONE;
+
+                LanderState next = states[index];
+                Outcome outcome = move(next, action);
+
+                if (outcome.kind == Outcome::LANDED)
+                {
+                    float fuel_left = std::max(0.0f, next.fuel);
+                    best_landing = std::max(best_landing, fuel_left);
+
+                    Pad &pad = *pads[outcome.pad];
+                    atomic_max(pad.most_fuel_left, float_bits(fuel_left));
+                    atomic_min(pad.earliest_step, depths[index] * DECISION_STEPS + outcome.steps);
+                }
+                if (outcome.kind != Outcome::CONTINUES) continue;
+
+                uint64_t cell_key = key(next);
+                if (cell_key == StateSet::EMPTY) continue;
+
+                uint32_t slot = set.insert(cell_key);
+                if (slot == NONE)
+                {
+                    *full = true;
+                    continue;
+                }
+                if (set.offer(slot, StateSet::make_offer(fuel_step(next), index, action))) found.push_back(slot);
+                successor = slot;
+            }
+            land_now[index] = best_landing;
+        }
+    }
+};
+
+// Splits [0, count) across the threads and waits for them all
+template <typename Work>
+static void parallel_for(int threads, uint32_t count, Work work)
+{
+    std::vector<std::thread> workers;
+    uint32_t chunk = (count + threads - 1) / threads;
+    for (int t = 0; t < threads; t++)
+    {
+        uint32_t first = std::min(count, chunk * t);
+        uint32_t last  = std::min(count, first + chunk);
+        workers.push_back(std::thread(work, t, first, last));
+    }
+    for (std::thread &worker : workers) worker.join();
+}
+
+// ————— LEVEL FILES ————— //
+// Any run of digits is a tile; each line with at least one is a row
+static bool load_level(const char *path, std::vector<unsigned int> &tiles, int *width, int *height)
+{
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) return false;
+
+    tiles.clear();
+    *width  = 0;
+    *height = 0;
+
+    char line[4096];
+    bool valid = true;
+    while (valid && fgets(line, sizeof(line), file) != nullptr)
+    {
+        int row = 0;
+        for (char *cursor = line; *cursor != '\0'; )
+        {
+            if (*cursor < '0' || *cursor > '9')
+            {
+                cursor++;
+                continue;
+            }
+            tiles.push_back((unsigned int) strtoul(cursor, &cursor, 10));
+            row++;
+        }
+        if (row == 0) continue;
+
+        if (*height == 0) *width = row;
+        valid = row == *width;
+        (*height)++;
+    }
+    fclose(file);
+    return valid && *height > 0;
+}
+
+// ————— HEATMAP ————— //
+static void blend(unsigned char *pixel, float t)
+{
+    // Red (nothing here can land any more) through yellow to green (all can)
+    static const unsigned char RED[3] = { 215, 48, 39 }, YELLOW[3] = { 250, 220, 80 }, GREEN[3] = { 60, 190, 90 };
+
+    const unsigned char *from = t < 0.5f ? RED : YELLOW;
+    const unsigned char *to   = t < 0.5f ? YELLOW : GREEN;
+    float u = t < 0.5f ? t * 2.0f : t * 2.0f - 1.0f;
+    for (int c = 0; c < 3; c++) pixel[c] = (unsigned char) (from[c] + (to[c] - from[c]) * u + 0.5f);
+}
+
+static bool write_heatmap(const Analyser &analyser, const std::vector<char> &latest,
+                          const std::vector<float> &best_left, const char *path)
+{
+    const Map &map = *analyser.map;
+    const int cells = analyser.cells_x * analyser.cells_y;
+
+    // Per position cell: how many states got there, and how many of them
+    // could still go on to land
+    std::vector<uint32_t> reached(cells, 0), landable(cells, 0);
+    for (size_t i = 0; i < analyser.states.size(); i++)
+    {
+        if (!latest[i]) continue;
+
+        const LanderState &state = analyser.states[i];
+        int x = Analyser::cell(state.x, analyser.min_x, POSITION_STEP);
+        int y = Analyser::cell(state.y, analyser.min_y, POSITION_STEP);
+        int index = y * analyser.cells_x + x;
+
+        reached[index]++;
+        if (best_left[i] >= 0.0f) landable[index]++;
+    }
+
+    const int scale  = analyser.settings.scale;
+    const int width  = analyser.cells_x * scale;
+    const int height = analyser.cells_y * scale;
+    std::vector<unsigned char> pixels((size_t) width * height * 3);
+
+    for (int row = 0; row < height; row++)
+    {
+        for (int column = 0; column < width; column++)
+        {
+            unsigned char *pixel = &pixels[((size_t) row * width + column) * 3];
+
+            // Image rows run top down, the grid bottom up
+            float world_x = analyser.min_x + (column + 0.5f) / scale * POSITION_STEP;
+            float world_y = analyser.min_y + (height - row - 0.5f) / scale * POSITION_STEP;
+
+            int tile = map.get_tile_type((int) floorf(world_x / map.get_tile_size()),
+                                         (int) floorf(-world_y / map.get_tile_size()));
+            int cell = (int) ((height - 1 - row) / scale) * analyser.cells_x + column / scale;
+
+            if (tile == (int) Map::LANDING_PAD_TILE) { pixel[0] = 70;  pixel[1] = 200; pixel[2] = 230; }
+            else if (tile > 0)                       { pixel[0] = 90;  pixel[1] = 80;  pixel[2] = 75;  }
+            else if (reached[cell] == 0)             { pixel[0] = 18;  pixel[1] = 18;  pixel[2] = 32;  }
+            else blend(pixel, (float) landable[cell] / reached[cell]);
+        }
+    }
+
+    // A white cross on the spawn
+    int spawn_column = (int) ((analyser.settings.spawn_x - analyser.min_x) / POSITION_STEP * scale);
+    int spawn_row    = height - 1 - (int) ((analyser.settings.spawn_y - analyser.min_y) / POSITION_STEP * scale);
+    for (int d = -scale; d <= scale; d++)
+    {
+        const int points[2][2] = { { spawn_column + d, spawn_row }, { spawn_column, spawn_row + d } };
+        for (int p = 0; p < 2; p++)
+        {
+            if (points[p][0] < 0 || points[p][0] >= width || points[p][1] < 0 || points[p][1] >= height) continue;
+            memset(&pixels[((size_t) points[p][1] * width + points[p][0]) * 3], 255, 3);
+        }
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr) return false;
+    fprintf(file, "P6\n%d %d\n255\n", width, height);
+    bool written = fwrite(pixels.data(), 1, pixels.size(), file) == pixels.size();
+    return fclose(file) == 0 && written;
+}
+
+static void usage()
+{
+    fprintf(stderr, "usage: reachability [--level FILE] [--spawn X Y] [--fuel F] [--touchdown-speed S]\n"
+                    "                    [--heatmap FILE] [--scale PIXELS] [--threads N] [--max-states N]\n");
+}
+
+int main(int argc, char *argv[])
+{
+    Settings settings;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--level") == 0 && i + 1 < argc) settings.level_path = argv[++i];
+        else if (strcmp(argv[i], "--spawn") == 0 && i + 2 < argc)
+        {
+            settings.spawn_x = (float) atof(argv[++i]);
+            settings.spawn_y = (float) atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--fuel") == 0 && i + 1 < argc) settings.fuel = std::max(0.0f, (float) atof(argv[++i]));
+        else if (strcmp(argv[i], "--touchdown-speed") == 0 && i + 1 < argc) settings.touchdown_speed = (float) atof(argv[++i]);
+        else if (strcmp(argv[i], "--heatmap") == 0 && i + 1 < argc) settings.heatmap_path = argv[++i];
+        else if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc) settings.scale = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) settings.threads = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--max-states") == 0 && i + 1 < argc) settings.max_states = (uint32_t) std::max(1, atoi(argv[++i]));
+        else { usage(); return 1; }
+    }
+
+    std::vector<unsigned int> tiles(LEVEL_1_DATA, LEVEL_1_DATA + LEVEL_1_WIDTH * LEVEL_1_HEIGHT);
+    int width = LEVEL_1_WIDTH, height = LEVEL_1_HEIGHT;
+    if (settings.level_path != nullptr && !load_level(settings.level_path, tiles, &width, &height))
+    {
+        fprintf(stderr, "reachability: couldn't read a level from %s\n", settings.level_path);
+        return 1;
+    }
+
+    // No texture: the map never renders here
+    Map map(width, height, tiles.data(), 0, 1.0f, 4, 1);
+
+    Analyser analyser;
+    analyser.map      = &map;
+    analyser.settings = settings;
+    analyser.find_pads();
+    analyser.size_grid();
+
+    printf("reachability: %dx%d level, spawn (%.2f, %.2f) with %.0f fuel, %d moves of %.2fs, %d threads\n",
+           width, height, settings.spawn_x, settings.spawn_y, settings.fuel,
+           ACTION_COUNT, DECISION_STEPS * PHYSICS_STEP, settings.threads);
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+
+    StateSet set(settings.max_states);
+
+    LanderState spawn;
+    spawn.x    = settings.spawn_x;
+    spawn.y    = settings.spawn_y;
+    spawn.fuel = settings.fuel;
+
+    if (analyser.key(spawn) == StateSet::EMPTY)
+    {
+        fprintf(stderr, "reachability: the spawn is outside the map\n");
+        return 1;
+    }
+    int spawn_pad;
+    if (analyser.touching(spawn, &spawn_pad) > 0)
+    {
+        fprintf(stderr, "reachability: the spawn is inside a tile\n");
+        return 1;
+    }
+    uint32_t spawn_slot = set.insert(analyser.key(spawn));
+    set.offer(spawn_slot, StateSet::make_offer(Analyser::fuel_step(spawn), 0, 0));
+    set.dequeue(spawn_slot, 0);
+    analyser.states.push_back(spawn);
+    analyser.cells.push_back(spawn_slot);
+    analyser.depths.push_back(0);
+
+    // ————— BREADTH-FIRST SEARCH ————— //
+    // Each level explores every state queued by the one before. The cells it
+    // queues are then sorted by where their winning offers came from and
+    // numbered in that order, so the numbering (and so everything after) is
+    // the same whatever the thread count.
+    std::vector<std::vector<uint32_t>> found(settings.threads);
+    std::vector<uint32_t> queued;
+
+    bool     full = false;
+    uint32_t level_begin = 0, level_end = 1, depth = 0;
+    while (level_begin < level_end && !full)
+    {
+        analyser.successors.resize((size_t) level_end * ACTION_COUNT);
+        analyser.land_now.resize(level_end);
+
+        std::vector<char> thread_full(settings.threads, 0);
+        parallel_for(settings.threads, level_end - level_begin,
+                     [&analyser, &set, &found, &thread_full, level_begin](int t, uint32_t first, uint32_t last) {
+            bool full_here = false;
+            analyser.expand(set, level_begin + first, level_begin + last, found[t], &full_here);
+            thread_full[t] = full_here;
+        });
+        full = std::find(thread_full.begin(), thread_full.end(), 1) != thread_full.end();
+
+        queued.clear();
+        for (std::vector<uint32_t> &slots : found)
+        {
+            queued.insert(queued.end(), slots.begin(), slots.end());
+            slots.clear();
+        }
+        // Lower bits of an offer are its origin, reversed
+        std::sort(queued.begin(), queued.end(), [&set](uint32_t a, uint32_t b) {
+            return (set.get_offer(a) & 0xFFFFFFFFFFull) > (set.get_offer(b) & 0xFFFFFFFFFFull);
+        });
+
+        if (analyser.states.size() + queued.size() > settings.max_states)
+        {
+            full = true;
+            queued.resize(settings.max_states - analyser.states.size());
+        }
+
+        uint32_t next_begin = (uint32_t) analyser.states.size();
+        analyser.states.resize(next_begin + queued.size());
+        analyser.cells.insert(analyser.cells.end(), queued.begin(), queued.end());
+        analyser.depths.resize(next_begin + queued.size(), depth + 1);
+
+        // Each new state starts exactly where its winning offer's move ended
+        parallel_for(settings.threads, (uint32_t) queued.size(), [&analyser, &set, &queued, next_begin](int, uint32_t first, uint32_t last) {
+            for (uint32_t i = first; i < last; i++)
+            {
+                uint64_t offer = set.dequeue(queued[i], next_begin + i);
+                LanderState state = analyser.states[StateSet::offer_parent(offer)];
+                analyser.move(state, StateSet::offer_action(offer));
+                analyser.states[next_begin + i] = state;
+            }
+        });
+
+        level_begin = level_end;
+        level_end   = (uint32_t) analyser.states.size();
+        depth++;
+
+        if (depth % 5 == 0) printf("  %u moves: %u new states, %u in all\n", depth, level_end - level_begin, level_end);
+    }
+
+    const uint32_t state_count = (uint32_t) analyser.states.size();
+    if (full)
+    {
+        printf("warning: stopped at --max-states %u; the results below are a lower bound\n", settings.max_states);
+        analyser.successors.resize((size_t) state_count * ACTION_COUNT, NONE);
+        analyser.land_now.resize(state_count, -1.0f);
+    }
+
+    // Successors were slots while states were still being numbered; each
+    // now goes to the best-fuelled state its cell was explored as
+    parallel_for(settings.threads, state_count, [&analyser, &set](int, uint32_t first, uint32_t last) {
+        for (size_t i = (size_t) first * ACTION_COUNT; i < (size_t) last * ACTION_COUNT; i++)
+        {
+            uint32_t &successor = analyser.successors[i];
+            if (successor != NONE) successor = set.get_index(successor);
+        }
+    });
+
+    float search_seconds = std::chrono::duration<float>(Clock::now() - start).count();
+
+    // ————— CRASH REGIONS ————— //
+    // The most fuel each state can still land with (-1 if it can't), passed
+    // back from landings along the moves until nothing changes
+    std::vector<float> best_left(analyser.land_now), next_left(state_count);
+    std::vector<char>  changed(settings.threads);
+
+    int sweeps = 0;
+    for (bool any_changed = true; any_changed; sweeps++)
+    {
+        parallel_for(settings.threads, state_count, [&](int t, uint32_t first, uint32_t last) {
+            bool changed_here = false;
+            for (uint32_t i = first; i < last; i++)
+            {
+                float best = analyser.land_now[i];
+                const uint32_t *options = &analyser.successors[(size_t) i * ACTION_COUNT];
+                for (int action = 0; action < ACTION_COUNT; action++)
+                {
+                    if (options[action] != NONE) best = std::max(best, best_left[options[action]]);
+                }
+                next_left[i]  = best;
+                changed_here |= best != best_left[i];
+            }
+            changed[t] = changed_here;
+        });
+        best_left.swap(next_left);
+        any_changed = std::find(changed.begin(), changed.end(), 1) != changed.end();
+    }
+
+    // Only a cell's best-fuelled state counts from here on
+    std::vector<char> latest(state_count);
+    uint32_t cell_count = 0, doomed = 0;
+    for (uint32_t i = 0; i < state_count; i++)
+    {
+        latest[i] = set.get_index(analyser.cells[i]) == i;
+        cell_count += latest[i];
+        doomed     += latest[i] && best_left[i] < 0.0f;
+    }
+
+    float seconds = std::chrono::duration<float>(Clock::now() - start).count();
+    printf("explored %u states in %u cells, %u moves deep, in %.1fs (%.1fs more for %d crash sweeps)\n",
+           state_count, cell_count, depth, search_seconds, seconds - search_seconds, sweeps);
+
+    // ————— REPORT ————— //
+    int unreachable = 0;
+    for (size_t p = 0; p < analyser.pads.size(); p++)
+    {
+        const Pad &pad = *analyser.pads[p];
+        float left  = (float) pad.tile_x * map.get_tile_size();
+        float right = (float) (pad.tile_x + pad.tile_count) * map.get_tile_size();
+        float top   = -(float) pad.tile_y * map.get_tile_size();
+
+        printf("  pad %zu, x %.0f-%.0f at y %.0f: ", p + 1, left, right, top);
+        if (!pad.reached())
+        {
+            printf("UNREACHABLE\n");
+            unreachable++;
+            continue;
+        }
+        printf("needs %.0f fuel, first reached after %.1fs\n",
+               settings.fuel - bits_float(pad.most_fuel_left.load()), pad.earliest_step.load() * PHYSICS_STEP);
+    }
+    if (analyser.pads.empty()) printf("  the level has no landing pads\n");
+
+    printf("%d of %zu pads unreachable; %.1f%% of the cells reached are already doomed to crash\n",
+           unreachable, analyser.pads.size(), 100.0f * doomed / cell_count);
+    if (best_left[0] < 0.0f) printf("no landing is possible from the spawn\n");
+
+    bool written = write_heatmap(analyser, latest, best_left, settings.heatmap_path);
+    for (Pad *pad : analyser.pads) delete pad;
+
+    if (!written)
+    {
+        fprintf(stderr, "reachability: couldn't write %s\n", settings.heatmap_path);
+        return 1;
+    }
+    printf("heatmap written to %s\n", settings.heatmap_path);
+    return 0;
+}